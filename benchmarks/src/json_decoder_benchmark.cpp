@@ -0,0 +1,123 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+// Measures json_decoder building deeply nested and wide documents, where the cost
+// of assembling arrays and objects outweighs parsing the scalars
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+size_t allocations = 0;
+
+}
+
+void* operator new(size_t n)
+{
+    ++allocations;
+    void* p = std::malloc(n > 0 ? n : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) JSONCONS_NOEXCEPT
+{
+    std::free(p);
+}
+
+namespace {
+
+// Objects nested depth levels deep, each level holding a few scalars and an array
+void write_nested(std::ostream& os, size_t depth, size_t i)
+{
+    os << "{\"id\":" << i << ",\"name\":\"node" << depth << "\",\"weights\":[1,2.5,3,4.25],\"child\":";
+    if (depth == 0)
+    {
+        os << "null";
+    }
+    else
+    {
+        write_nested(os, depth-1, i);
+    }
+    os << ",\"ok\":true}";
+}
+
+std::string make_nested(size_t records, size_t depth)
+{
+    std::ostringstream os;
+    os << "[";
+    for (size_t i = 0; i < records; ++i)
+    {
+        if (i > 0)
+        {
+            os << ",";
+        }
+        write_nested(os, depth, i);
+    }
+    os << "]";
+    return os.str();
+}
+
+struct result
+{
+    double ms;
+    size_t allocations;
+};
+
+// Best time of several decodes, and the number of allocations made by one
+template <class Json>
+result measure(const std::string& text)
+{
+    result r = {0, 0};
+    for (int k = 0; k < 5; ++k)
+    {
+        std::istringstream is(text);
+        json_decoder<Json> decoder;
+        json_reader reader(is, decoder);
+        size_t start_allocations = allocations;
+        auto start = std::chrono::high_resolution_clock::now();
+        reader.read();
+        auto end = std::chrono::high_resolution_clock::now();
+        r.allocations = allocations - start_allocations;
+        Json j = decoder.get_result();
+        double ms = std::chrono::duration<double,std::milli>(end - start).count();
+        if (k == 0 || ms < r.ms)
+        {
+            r.ms = ms;
+        }
+    }
+    return r;
+}
+
+template <class Json>
+void report(const char* name, const std::string& text)
+{
+    result r = measure<Json>(text);
+    std::cout << name << ": " << r.ms << " ms, " << r.allocations << " allocations\n";
+}
+
+}
+
+int main()
+{
+    const std::string deep = make_nested(2000, 64);
+    const std::string shallow = make_nested(100000, 2);
+
+    report<json>("json, depth 64", deep);
+    report<ojson>("ojson, depth 64", deep);
+    report<json>("json, depth 2", shallow);
+    report<ojson>("ojson, depth 2", shallow);
+}
@@ -0,0 +1,66 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+// Compares reading a large JSON file through std::ifstream with reading it through
+// a memory mapping
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/source.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+void make_file(const std::string& path, size_t records)
+{
+    std::ofstream os(path);
+    os << "[";
+    for (size_t i = 0; i < records; ++i)
+    {
+        if (i > 0)
+        {
+            os << ",\n";
+        }
+        os << "{\"id\":" << i << ",\"level\":\"info\",\"message\":\"request served in " << (i % 997)
+           << " ms\",\"tags\":[\"http\",\"get\"],\"latency\":" << (i % 1000) * 0.25 << "}";
+    }
+    os << "]";
+}
+
+template <class Reader, class Source>
+double measure(Source&& source)
+{
+    basic_null_json_input_handler<char> handler;
+    auto start = std::chrono::high_resolution_clock::now();
+    Reader reader(std::forward<Source>(source), handler);
+    reader.read();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double,std::milli>(end - start).count();
+}
+
+}
+
+int main()
+{
+    const std::string path = "json_reader_source_benchmark.json";
+    make_file(path, 2000000);
+
+    for (int k = 0; k < 3; ++k)
+    {
+        std::ifstream is(path);
+        double t1 = measure<json_reader>(is);
+#if defined(JSONCONS_HAS_POSIX_MMAP)
+        double t2 = measure<basic_json_reader<char,std::allocator<char>,mmap_source<char>>>(path);
+        std::cout << "ifstream: " << t1 << " ms, mmap: " << t2 << " ms\n";
+#else
+        std::cout << "ifstream: " << t1 << " ms\n";
+#endif
+    }
+    std::remove(path.c_str());
+}
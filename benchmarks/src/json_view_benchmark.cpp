@@ -0,0 +1,90 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+// Compares parsing into json and into a json_tape, and walking every value of the result
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_view.hpp>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+std::string make_records(size_t count)
+{
+    std::ostringstream os;
+    os << "[";
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0)
+        {
+            os << ",";
+        }
+        os << "{\"id\":" << i << ",\"name\":\"record " << i << "\",\"score\":" << (i % 100) * 0.5
+           << ",\"tags\":[\"a\",\"b\",\"c\"],\"active\":" << (i % 2 == 0 ? "true" : "false") << "}";
+    }
+    os << "]";
+    return os.str();
+}
+
+template <class F>
+double best_of(F f)
+{
+    double best = 0;
+    for (int k = 0; k < 5; ++k)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        f();
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double,std::milli>(end - start).count();
+        if (k == 0 || ms < best)
+        {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+double sum_scores(const json& j)
+{
+    double sum = 0;
+    for (const auto& record : j.array_range())
+    {
+        sum += record["score"].as<double>() + record["tags"].size();
+    }
+    return sum;
+}
+
+double sum_scores(const json_view& v)
+{
+    double sum = 0;
+    for (auto record : v.array_range())
+    {
+        sum += record["score"].as<double>() + record["tags"].size();
+    }
+    return sum;
+}
+
+}
+
+int main()
+{
+    const std::string text = make_records(200000);
+
+    json j;
+    json_tape tape;
+    double parse_json = best_of([&](){j = json::parse(text);});
+    double parse_tape = best_of([&](){tape = json_tape::parse(text);});
+
+    double sum = 0;
+    double query_json = best_of([&](){sum += sum_scores(j);});
+    double query_tape = best_of([&](){sum += sum_scores(tape.root());});
+
+    std::cout << "parse json: " << parse_json << " ms, json_tape: " << parse_tape << " ms\n";
+    std::cout << "query json: " << query_json << " ms, json_view: " << query_tape << " ms\n";
+    std::cout << "(" << sum << ")\n";
+}
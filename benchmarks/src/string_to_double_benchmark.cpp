@@ -0,0 +1,111 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+// Compares detail::string_to_double with the strtod based conversion it replaces,
+// on floating point tokens of the shapes found in numeric feeds
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/number_parsers.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+std::vector<std::string> make_tokens(const char* format, size_t count)
+{
+    std::mt19937_64 gen(12345);
+    std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+    std::vector<std::string> tokens;
+    tokens.reserve(count);
+    char buf[64];
+    for (size_t i = 0; i < count; ++i)
+    {
+        double d = std::abs(dist(gen)) * std::pow(10.0, static_cast<int>(i % 21) - 10);
+        std::snprintf(buf, sizeof(buf), format, d);
+        tokens.push_back(buf);
+    }
+    return tokens;
+}
+
+template <class F>
+double measure(const std::vector<std::string>& tokens, F f, double& checksum)
+{
+    const int rounds = 5;
+    checksum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int k = 0; k < rounds; ++k)
+    {
+        for (const auto& s : tokens)
+        {
+            checksum += f(s);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double,std::nano>(end - start).count() / (rounds * tokens.size());
+}
+
+void run(const char* name, const char* format)
+{
+    std::vector<std::string> tokens = make_tokens(format, 1000000);
+
+    detail::string_to_double to_double;
+    double checksum1;
+    double t1 = measure(tokens, [](const std::string& s) {return std::strtod(s.c_str(), nullptr);}, checksum1);
+    double checksum2;
+    double t2 = measure(tokens, [&](const std::string& s) {return to_double(s.c_str(), s.length());}, checksum2);
+
+    size_t mismatches = 0;
+    for (const auto& s : tokens)
+    {
+        double expected = std::strtod(s.c_str(), nullptr);
+        double actual = to_double(s.c_str(), s.length());
+        if (std::memcmp(&expected, &actual, sizeof(double)) != 0)
+        {
+            ++mismatches;
+        }
+    }
+
+    std::cout << name << " (e.g. " << tokens[7] << ")\n"
+              << "    strtod:            " << t1 << " ns/token\n"
+              << "    string_to_double:  " << t2 << " ns/token\n"
+              << "    mismatches:        " << mismatches << "\n";
+}
+
+void run_parse()
+{
+    std::vector<std::string> tokens = make_tokens("%.17g", 1000000);
+    std::string text = "[";
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        if (i > 0)
+        {
+            text.push_back(',');
+        }
+        text.append(tokens[i]);
+    }
+    text.push_back(']');
+
+    auto start = std::chrono::high_resolution_clock::now();
+    json j = json::parse(text);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "json::parse of " << j.size() << " doubles (" << text.size() << " bytes): "
+              << std::chrono::duration<double,std::milli>(end - start).count() << " ms\n";
+}
+
+}
+
+int main()
+{
+    run("shortest round trip", "%.17g");
+    run("six decimals", "%.6f");
+    run("scientific", "%.9e");
+    run_parse();
+}
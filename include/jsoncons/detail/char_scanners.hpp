@@ -0,0 +1,309 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_CHARSCANNERS_HPP
+#define JSONCONS_DETAIL_CHARSCANNERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <limits>
+#include <jsoncons/jsoncons_config.hpp>
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_AVX2_DISPATCH)
+#include <immintrin.h>
+#elif defined(JSONCONS_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+#define JSONCONS_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define JSONCONS_AVX2_TARGET
+#endif
+
+namespace jsoncons { namespace detail {
+
+inline unsigned count_trailing_zeros(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    unsigned n = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline unsigned count_trailing_zeros(uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    uint32_t low = static_cast<uint32_t>(mask);
+    return low != 0 ? count_trailing_zeros(low) : 32 + count_trailing_zeros(static_cast<uint32_t>(mask >> 32));
+#endif
+}
+
+// cpu_has_avx2
+
+inline bool cpu_has_avx2()
+{
+#if defined(JSONCONS_HAS_AVX2)
+    return true;
+#elif defined(JSONCONS_HAS_AVX2_DISPATCH)
+    static const bool value = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+    return value;
+#else
+    return false;
+#endif
+}
+
+// Portable eight-bytes-at-a-time tests, see "Bit Twiddling Hacks"
+
+inline uint64_t load_uint64(const char* p)
+{
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t has_zero_byte(uint64_t v)
+{
+    return (v - 0x0101010101010101ULL) & ~v & 0x8080808080808080ULL;
+}
+
+inline uint64_t has_byte(uint64_t v, uint8_t c)
+{
+    return has_zero_byte(v ^ (0x0101010101010101ULL * c));
+}
+
+inline uint64_t has_byte_less_than(uint64_t v, uint8_t n)
+{
+    return (v - 0x0101010101010101ULL * n) & ~v & 0x8080808080808080ULL;
+}
+
+// The block scanners below advance over whole blocks that contain no match. They return
+// either a pointer to the first match or the start of a tail shorter than one block.
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_AVX2_DISPATCH)
+
+JSONCONS_AVX2_TARGET
+inline const char* find_string_special_avx2(const char* first, const char* last)
+{
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i max_control = _mm256_set1_epi8(0x1f);
+    while (last - first >= 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        __m256i special = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(v, max_control), max_control));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask);
+        }
+        first += 32;
+    }
+    return first;
+}
+
+JSONCONS_AVX2_TARGET
+inline const char* skip_blanks_avx2(const char* first, const char* last)
+{
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    while (last - first >= 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        __m256i blank = _mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab));
+        uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(blank));
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask);
+        }
+        first += 32;
+    }
+    return first;
+}
+
+#endif
+
+#if defined(JSONCONS_HAS_SSE2)
+
+inline const char* find_string_special_sse2(const char* first, const char* last, 
+                                           size_t max_length = (std::numeric_limits<size_t>::max)())
+{
+    if (static_cast<size_t>(last - first) > max_length)
+    {
+        last = first + max_length;
+    }
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i max_control = _mm_set1_epi8(0x1f);
+    while (last - first >= 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(v, max_control), max_control));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask);
+        }
+        first += 16;
+    }
+    return first;
+}
+
+inline const char* skip_blanks_sse2(const char* first, const char* last, 
+                                   size_t max_length = (std::numeric_limits<size_t>::max)())
+{
+    if (static_cast<size_t>(last - first) > max_length)
+    {
+        last = first + max_length;
+    }
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    while (last - first >= 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab));
+        uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(blank)) & 0xffff;
+        if (mask != 0)
+        {
+            return first + count_trailing_zeros(mask);
+        }
+        first += 16;
+    }
+    return first;
+}
+
+#endif
+
+inline const char* find_string_special_swar(const char* first, const char* last)
+{
+    while (last - first >= 8)
+    {
+        uint64_t v = load_uint64(first);
+        if (has_byte(v, '\"') | has_byte(v, '\\') | has_byte_less_than(v, 0x20))
+        {
+            break;
+        }
+        first += 8;
+    }
+    return first;
+}
+
+// is_string_special
+
+template <class CharT>
+bool is_string_special(CharT c)
+{
+    typedef typename std::make_unsigned<CharT>::type uchar_type;
+    return c == '\"' || c == '\\' || static_cast<uchar_type>(c) < 0x20;
+}
+
+// find_string_special
+// Returns a pointer to the first quotation mark, reverse solidus or control character
+// (U+0000 through U+001F) in [first,last), or last if there is none. Everything before
+// the returned pointer is literal string content.
+
+template <class CharT>
+const CharT* find_string_special(const CharT* first, const CharT* last)
+{
+    while (first != last && !is_string_special(*first))
+    {
+        ++first;
+    }
+    return first;
+}
+
+inline const char* find_string_special(const char* first, const char* last)
+{
+#if defined(JSONCONS_HAS_SSE2)
+    first = find_string_special_sse2(first, last, 16);
+#endif
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_AVX2_DISPATCH)
+    // Only strings longer than one SSE2 block are worth the call through the dispatch
+    if (last - first >= 32 && !is_string_special(*first) && cpu_has_avx2())
+    {
+        first = find_string_special_avx2(first, last);
+    }
+#endif
+#if defined(JSONCONS_HAS_SSE2)
+    first = find_string_special_sse2(first, last);
+#else
+    first = find_string_special_swar(first, last);
+#endif
+    while (first != last && !is_string_special(*first))
+    {
+        ++first;
+    }
+    return first;
+}
+
+// skip_blanks
+// Returns a pointer to the first character in [first,last) that is not a space or
+// horizontal tab, or last if there is none.
+
+template <class CharT>
+const CharT* skip_blanks(const CharT* first, const CharT* last)
+{
+    while (first != last && (*first == ' ' || *first == '\t'))
+    {
+        ++first;
+    }
+    return first;
+}
+
+inline const char* skip_blanks(const char* first, const char* last)
+{
+    // Most runs between tokens are a single space, don't pay for a block load
+    if (first == last || (*first != ' ' && *first != '\t'))
+    {
+        return first;
+    }
+#if defined(JSONCONS_HAS_SSE2)
+    first = skip_blanks_sse2(first, last, 16);
+#endif
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_AVX2_DISPATCH)
+    if (last - first >= 32 && (*first == ' ' || *first == '\t') && cpu_has_avx2())
+    {
+        first = skip_blanks_avx2(first, last);
+    }
+#endif
+#if defined(JSONCONS_HAS_SSE2)
+    first = skip_blanks_sse2(first, last);
+#endif
+    while (first != last && (*first == ' ' || *first == '\t'))
+    {
+        ++first;
+    }
+    return first;
+}
+
+}}
+
+#endif
@@ -0,0 +1,107 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_COUNTEDNODE_HPP
+#define JSONCONS_DETAIL_COUNTEDNODE_HPP
+
+#include <atomic>
+#include <utility>
+#include <jsoncons/jsoncons_config.hpp>
+
+namespace jsoncons { namespace detail {
+
+// counted_node
+// The heap allocation behind an array or object value. With Counted, the node carries an
+// atomic reference count and may be shared by several values, which copy it before changing
+// it. Without, it has exactly one owner and holds nothing but the value.
+
+template <class T, bool Counted>
+class counted_node;
+
+template <class T>
+class counted_node<T,false>
+{
+    T value_;
+public:
+    template <class... Args>
+    explicit counted_node(Args&&... args)
+        : value_(std::forward<Args>(args)...)
+    {
+    }
+
+    T& value()
+    {
+        return value_;
+    }
+
+    const T& value() const
+    {
+        return value_;
+    }
+
+    bool is_shared() const
+    {
+        return false;
+    }
+
+    void add_ref()
+    {
+    }
+
+    // Returns true if the caller was the last owner
+    bool release()
+    {
+        return true;
+    }
+};
+
+template <class T>
+class counted_node<T,true>
+{
+    std::atomic<size_t> count_;
+    T value_;
+public:
+    template <class... Args>
+    explicit counted_node(Args&&... args)
+        : count_(1), value_(std::forward<Args>(args)...)
+    {
+    }
+
+    T& value()
+    {
+        return value_;
+    }
+
+    const T& value() const
+    {
+        return value_;
+    }
+
+    bool is_shared() const
+    {
+        return count_.load(std::memory_order_acquire) > 1;
+    }
+
+    size_t use_count() const
+    {
+        return count_.load(std::memory_order_acquire);
+    }
+
+    void add_ref()
+    {
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Returns true if the caller was the last owner
+    bool release()
+    {
+        return count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+};
+
+}}
+
+#endif
@@ -0,0 +1,312 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_GRISU3_HPP
+#define JSONCONS_DETAIL_GRISU3_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <jsoncons/jsoncons_config.hpp>
+
+namespace jsoncons { namespace detail {
+
+// Shortest decimal digits that round trip to a double, after Loitsch, "Printing
+// Floating-Point Numbers Quickly and Accurately with Integers", and the Grisu3 code of
+// the double-conversion library. Grisu3 gives up on about 0.5% of doubles, callers then
+// fall back to a slower method.
+
+struct diy_fp
+{
+    uint64_t f;
+    int e;
+
+    diy_fp()
+        : f(0), e(0)
+    {
+    }
+
+    diy_fp(uint64_t significand, int exponent)
+        : f(significand), e(exponent)
+    {
+    }
+
+    // The upper 64 bits of the product, rounded
+    diy_fp times(const diy_fp& other) const
+    {
+        const uint64_t mask32 = 0xFFFFFFFF;
+        uint64_t a = f >> 32;
+        uint64_t b = f & mask32;
+        uint64_t c = other.f >> 32;
+        uint64_t d = other.f & mask32;
+        uint64_t ac = a * c;
+        uint64_t bc = b * c;
+        uint64_t ad = a * d;
+        uint64_t bd = b * d;
+        uint64_t tmp = (bd >> 32) + (ad & mask32) + (bc & mask32);
+        tmp += uint64_t(1) << 31;
+        return diy_fp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), e + other.e + 64);
+    }
+
+    diy_fp normalized() const
+    {
+        diy_fp result = *this;
+        while ((result.f & (uint64_t(1) << 63)) == 0)
+        {
+            result.f <<= 1;
+            --result.e;
+        }
+        return result;
+    }
+};
+
+struct cached_power
+{
+    uint64_t significand;
+    int16_t binary_exponent;
+    int16_t decimal_exponent;
+};
+
+// Normalized, rounded 10^k for k in [-348,340] in steps of 8
+template <class T = void>
+struct cached_powers_of_ten
+{
+    static const cached_power table[87];
+};
+
+template <class T>
+const cached_power cached_powers_of_ten<T>::table[87] = {
+        {0xfa8fd5a0081c0288ULL, -1220, -348},
+        {0xbaaee17fa23ebf76ULL, -1193, -340},
+        {0x8b16fb203055ac76ULL, -1166, -332},
+        {0xcf42894a5dce35eaULL, -1140, -324},
+        {0x9a6bb0aa55653b2dULL, -1113, -316},
+        {0xe61acf033d1a45dfULL, -1087, -308},
+        {0xab70fe17c79ac6caULL, -1060, -300},
+        {0xff77b1fcbebcdc4fULL, -1034, -292},
+        {0xbe5691ef416bd60cULL, -1007, -284},
+        {0x8dd01fad907ffc3cULL, -980, -276},
+        {0xd3515c2831559a83ULL, -954, -268},
+        {0x9d71ac8fada6c9b5ULL, -927, -260},
+        {0xea9c227723ee8bcbULL, -901, -252},
+        {0xaecc49914078536dULL, -874, -244},
+        {0x823c12795db6ce57ULL, -847, -236},
+        {0xc21094364dfb5637ULL, -821, -228},
+        {0x9096ea6f3848984fULL, -794, -220},
+        {0xd77485cb25823ac7ULL, -768, -212},
+        {0xa086cfcd97bf97f4ULL, -741, -204},
+        {0xef340a98172aace5ULL, -715, -196},
+        {0xb23867fb2a35b28eULL, -688, -188},
+        {0x84c8d4dfd2c63f3bULL, -661, -180},
+        {0xc5dd44271ad3cdbaULL, -635, -172},
+        {0x936b9fcebb25c996ULL, -608, -164},
+        {0xdbac6c247d62a584ULL, -582, -156},
+        {0xa3ab66580d5fdaf6ULL, -555, -148},
+        {0xf3e2f893dec3f126ULL, -529, -140},
+        {0xb5b5ada8aaff80b8ULL, -502, -132},
+        {0x87625f056c7c4a8bULL, -475, -124},
+        {0xc9bcff6034c13053ULL, -449, -116},
+        {0x964e858c91ba2655ULL, -422, -108},
+        {0xdff9772470297ebdULL, -396, -100},
+        {0xa6dfbd9fb8e5b88fULL, -369, -92},
+        {0xf8a95fcf88747d94ULL, -343, -84},
+        {0xb94470938fa89bcfULL, -316, -76},
+        {0x8a08f0f8bf0f156bULL, -289, -68},
+        {0xcdb02555653131b6ULL, -263, -60},
+        {0x993fe2c6d07b7facULL, -236, -52},
+        {0xe45c10c42a2b3b06ULL, -210, -44},
+        {0xaa242499697392d3ULL, -183, -36},
+        {0xfd87b5f28300ca0eULL, -157, -28},
+        {0xbce5086492111aebULL, -130, -20},
+        {0x8cbccc096f5088ccULL, -103, -12},
+        {0xd1b71758e219652cULL, -77, -4},
+        {0x9c40000000000000ULL, -50, 4},
+        {0xe8d4a51000000000ULL, -24, 12},
+        {0xad78ebc5ac620000ULL, 3, 20},
+        {0x813f3978f8940984ULL, 30, 28},
+        {0xc097ce7bc90715b3ULL, 56, 36},
+        {0x8f7e32ce7bea5c70ULL, 83, 44},
+        {0xd5d238a4abe98068ULL, 109, 52},
+        {0x9f4f2726179a2245ULL, 136, 60},
+        {0xed63a231d4c4fb27ULL, 162, 68},
+        {0xb0de65388cc8ada8ULL, 189, 76},
+        {0x83c7088e1aab65dbULL, 216, 84},
+        {0xc45d1df942711d9aULL, 242, 92},
+        {0x924d692ca61be758ULL, 269, 100},
+        {0xda01ee641a708deaULL, 295, 108},
+        {0xa26da3999aef774aULL, 322, 116},
+        {0xf209787bb47d6b85ULL, 348, 124},
+        {0xb454e4a179dd1877ULL, 375, 132},
+        {0x865b86925b9bc5c2ULL, 402, 140},
+        {0xc83553c5c8965d3dULL, 428, 148},
+        {0x952ab45cfa97a0b3ULL, 455, 156},
+        {0xde469fbd99a05fe3ULL, 481, 164},
+        {0xa59bc234db398c25ULL, 508, 172},
+        {0xf6c69a72a3989f5cULL, 534, 180},
+        {0xb7dcbf5354e9beceULL, 561, 188},
+        {0x88fcf317f22241e2ULL, 588, 196},
+        {0xcc20ce9bd35c78a5ULL, 614, 204},
+        {0x98165af37b2153dfULL, 641, 212},
+        {0xe2a0b5dc971f303aULL, 667, 220},
+        {0xa8d9d1535ce3b396ULL, 694, 228},
+        {0xfb9b7cd9a4a7443cULL, 720, 236},
+        {0xbb764c4ca7a44410ULL, 747, 244},
+        {0x8bab8eefb6409c1aULL, 774, 252},
+        {0xd01fef10a657842cULL, 800, 260},
+        {0x9b10a4e5e9913129ULL, 827, 268},
+        {0xe7109bfba19c0c9dULL, 853, 276},
+        {0xac2820d9623bf429ULL, 880, 284},
+        {0x80444b5e7aa7cf85ULL, 907, 292},
+        {0xbf21e44003acdd2dULL, 933, 300},
+        {0x8e679c2f5e44ff8fULL, 960, 308},
+        {0xd433179d9c8cb841ULL, 986, 316},
+        {0x9e19db92b4e31ba9ULL, 1013, 324},
+        {0xeb96bf6ebadf77d9ULL, 1039, 332},
+        {0xaf87023b9bf0ee6bULL, 1066, 340}
+};
+
+inline bool grisu3_round_weed(char* buffer, int length, uint64_t distance_too_high_w, uint64_t unsafe_interval,
+                              uint64_t rest, uint64_t ten_kappa, uint64_t unit)
+{
+    uint64_t small_distance = distance_too_high_w - unit;
+    uint64_t big_distance = distance_too_high_w + unit;
+
+    // Move the last digit down while that brings the value closer to w
+    while (rest < small_distance &&
+           unsafe_interval - rest >= ten_kappa &&
+           (rest + ten_kappa < small_distance ||
+            small_distance - rest >= rest + ten_kappa - small_distance))
+    {
+        --buffer[length - 1];
+        rest += ten_kappa;
+    }
+
+    // If the other end of w's uncertainty could still prefer a different digit, give up
+    if (rest < big_distance &&
+        unsafe_interval - rest >= ten_kappa &&
+        (rest + ten_kappa < big_distance ||
+         big_distance - rest > rest + ten_kappa - big_distance))
+    {
+        return false;
+    }
+
+    return (2 * unit <= rest) && (rest <= unsafe_interval - 4 * unit);
+}
+
+inline bool grisu3_digit_gen(diy_fp low, diy_fp w, diy_fp high, char* buffer, int* length, int* kappa)
+{
+    uint64_t unit = 1;
+    diy_fp too_low(low.f - unit, low.e);
+    diy_fp too_high(high.f + unit, high.e);
+    uint64_t unsafe_interval = too_high.f - too_low.f;
+    diy_fp one(uint64_t(1) << -w.e, w.e);
+    uint32_t integrals = static_cast<uint32_t>(too_high.f >> -one.e);
+    uint64_t fractionals = too_high.f & (one.f - 1);
+
+    uint32_t divisor = 1000000000;
+    int divisor_exponent_plus_one = 10;
+    while (divisor_exponent_plus_one > 0 && integrals < divisor)
+    {
+        divisor /= 10;
+        --divisor_exponent_plus_one;
+    }
+
+    *kappa = divisor_exponent_plus_one;
+    *length = 0;
+    while (*kappa > 0)
+    {
+        uint32_t digit = integrals / divisor;
+        buffer[(*length)++] = static_cast<char>('0' + digit);
+        integrals %= divisor;
+        --(*kappa);
+        uint64_t rest = (static_cast<uint64_t>(integrals) << -one.e) + fractionals;
+        if (rest < unsafe_interval)
+        {
+            return grisu3_round_weed(buffer, *length, too_high.f - w.f, unsafe_interval, rest,
+                                     static_cast<uint64_t>(divisor) << -one.e, unit);
+        }
+        divisor /= 10;
+    }
+
+    for (;;)
+    {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        uint32_t digit = static_cast<uint32_t>(fractionals >> -one.e);
+        buffer[(*length)++] = static_cast<char>('0' + digit);
+        fractionals &= one.f - 1;
+        --(*kappa);
+        if (fractionals < unsafe_interval)
+        {
+            return grisu3_round_weed(buffer, *length, (too_high.f - w.f) * unit, unsafe_interval, fractionals,
+                                     one.f, unit);
+        }
+    }
+}
+
+// grisu3
+// v must be finite and positive. On success writes the shortest digits d1...dn that
+// round trip to v into buffer (at least 18 chars, not null terminated), with
+// v ~ d1...dn * 10^decimal_exponent, and returns true.
+
+inline bool grisu3(double v, char* buffer, int* length, int* decimal_exponent)
+{
+    const uint64_t significand_mask = 0x000FFFFFFFFFFFFFULL;
+    const uint64_t hidden_bit = 0x0010000000000000ULL;
+    const int exponent_bias = 0x3FF + 52;
+
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(v));
+    int biased_exponent = static_cast<int>((bits >> 52) & 0x7FF);
+    uint64_t significand = bits & significand_mask;
+
+    diy_fp w;
+    if (biased_exponent == 0)
+    {
+        w = diy_fp(significand, 1 - exponent_bias);
+    }
+    else
+    {
+        w = diy_fp(significand | hidden_bit, biased_exponent - exponent_bias);
+    }
+
+    // Boundaries halfway to the neighbouring doubles, the lower one is closer at powers of two
+    diy_fp plus = diy_fp((w.f << 1) + 1, w.e - 1).normalized();
+    diy_fp minus;
+    if (significand == 0 && biased_exponent > 1)
+    {
+        minus = diy_fp((w.f << 2) - 1, w.e - 2);
+    }
+    else
+    {
+        minus = diy_fp((w.f << 1) - 1, w.e - 1);
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    w = w.normalized();
+
+    // A cached power of ten that brings the binary exponent of w into [-60,-32]
+    const int minimal_target_exponent = -60;
+    int k = static_cast<int>(std::ceil((minimal_target_exponent - (w.e + 64) + 64 - 1) * 0.30102999566398114));
+    int index = (348 + k - 1) / 8 + 1;
+    const cached_power& cached = cached_powers_of_ten<>::table[index];
+    diy_fp ten_mk(cached.significand, cached.binary_exponent);
+
+    diy_fp scaled_w = w.times(ten_mk);
+    diy_fp scaled_minus = minus.times(ten_mk);
+    diy_fp scaled_plus = plus.times(ten_mk);
+
+    int kappa;
+    bool result = grisu3_digit_gen(scaled_minus, scaled_w, scaled_plus, buffer, length, &kappa);
+    *decimal_exponent = -cached.decimal_exponent + kappa;
+    return result;
+}
+
+}}
+
+#endif
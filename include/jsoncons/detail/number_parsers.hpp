@@ -22,6 +22,8 @@
 #include <algorithm>
 #include <exception>
 #include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/jsoncons_utilities.hpp>
+#include <jsoncons/detail/decimal_to_double.hpp>
 
 namespace jsoncons { namespace detail {
 
@@ -139,6 +141,10 @@ to_uinteger_result to_uinteger(const CharT* s, size_t length)
     return to_uinteger_result{ n,overflow };
 }
 
+// string_to_double
+// Decimals of up to 19 significant digits are converted by decimal_to_double, only
+// longer ones reach the C library conversion
+
 #if defined(JSONCONS_HAS_MSC__STRTOD_L)
 
 class string_to_double
@@ -160,11 +166,16 @@ public:
         return '.';
     }
 
-    double operator()(const char* s, size_t) const
+    double operator()(const char* s, size_t length) const
     {
+        double val;
+        if (decimal_to_double(s, length, val))
+        {
+            return val;
+        }
         const char *begin = s;
         char *end = nullptr;
-        double val = _strtod_l(begin, &end, locale_);
+        val = _strtod_l(begin, &end, locale_);
         if (begin == end)
         {
             JSONCONS_THROW(json_exception_impl<std::invalid_argument>("Invalid float value"));
@@ -200,9 +211,14 @@ public:
 
     double operator()(const char* s, size_t length) const
     {
+        double val;
+        if (decimal_to_double(s, length, val))
+        {
+            return val;
+        }
         const char *begin = s;
         char *end = nullptr;
-        double val = strtold_l(begin, &end, locale_);
+        val = strtold_l(begin, &end, locale_);
         if (begin == end)
         {
             JSONCONS_THROW(json_exception_impl<std::invalid_argument>("Invalid float value"));
@@ -243,10 +259,15 @@ public:
         return decimal_point_;
     }
 
-    double operator()(const char* s, size_t /*length*/) const
+    double operator()(const char* s, size_t length) const
     {
+        double val;
+        if (decimal_to_double(s, length, val, decimal_point_))
+        {
+            return val;
+        }
         char *end = nullptr;
-        double val = strtod(s, &end);
+        val = strtod(s, &end);
         if (s == end)
         {
             JSONCONS_THROW(json_exception_impl<std::invalid_argument>("string_to_double failed"));
@@ -261,6 +282,66 @@ private:
 };
 #endif
 
+// number_text_to_double
+// Converts a number token, an optional minus sign, digits with an optional fraction and an
+// optional exponent, as the parsers would have
+
+template <class CharT>
+double number_text_to_double(const CharT* s, size_t length)
+{
+    double val;
+    if (decimal_to_double(s, length, val))
+    {
+        return val;
+    }
+    string_to_double to_double;
+    std::string buffer;
+    buffer.reserve(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        buffer.push_back(s[i] == '.' ? to_double.get_decimal_point() : static_cast<char>(s[i]));
+    }
+    return to_double(buffer.c_str(), buffer.length());
+}
+
+// number_text_format
+// The format, precision and decimal places the parsers report with the value of a number token
+
+template <class CharT>
+number_format number_text_format(const CharT* s, size_t length)
+{
+    const CharT* p = s;
+    const CharT* end = s + length;
+    if (p != end && *p == '-')
+    {
+        ++p;
+    }
+    chars_format format = chars_format::general;
+    size_t precision = 0;
+    size_t decimal_places = 0;
+    for (; p != end && *p != 'e' && *p != 'E'; ++p)
+    {
+        if (*p == '.')
+        {
+            format = chars_format::fixed;
+        }
+        else
+        {
+            ++precision;
+            if (format == chars_format::fixed)
+            {
+                ++decimal_places;
+            }
+        }
+    }
+    if (p != end)
+    {
+        format = chars_format::scientific;
+    }
+    const size_t max_digits10 = std::numeric_limits<double>::max_digits10;
+    return number_format(format, static_cast<uint8_t>((std::min)(precision, max_digits10)), static_cast<uint8_t>(decimal_places));
+}
+
 }}
 
 #endif
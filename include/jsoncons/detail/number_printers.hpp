@@ -17,12 +17,16 @@
 #include <cstdlib>
 #include <cmath>
 #include <cstdarg>
+#include <cstdio>
+#include <cstring>
 #include <locale>
 #include <limits> 
 #include <algorithm>
 #include <exception>
 #include <jsoncons/jsoncons_config.hpp>
 #include <jsoncons/detail/obufferedstream.hpp>
+#include <jsoncons/detail/grisu3.hpp>
+#include <jsoncons/detail/decimal_to_double.hpp>
 
 namespace jsoncons { namespace detail {
 
@@ -71,12 +75,16 @@ void print_uinteger(uint64_t value, Writer& os)
 }
 
 // print_double
-
-#if defined(JSONCONS_HAS__ECVT_S)
+// Without a precision, from the options or from the number_format, prints the shortest
+// digits that read back as the same double. With a precision, prints the value rounded
+// to that many significant digits, as "%.*g" does. Either way the layout is that of %g
+// with ".0" appended to integral values, and does not depend on the C locale.
 
 class print_double
 {
 private:
+    static const int max_digits_length = 264;
+
     uint8_t precision_override_;
 public:
     print_double(uint8_t precision)
@@ -85,290 +93,171 @@ public:
     }
 
     template <class Writer>
-    void operator()(double val, uint8_t precision, Writer& writer) 
+    void operator()(double val, uint8_t precision, Writer& writer)
     {
-        typedef typename Writer::char_type char_type;
+        const int digits10 = std::numeric_limits<double>::digits10;
 
-        char buf[_CVTBUFSIZE];
-        int decimal_point = 0;
-        int sign = 0;
+        int prec = precision_override_ != 0 ? precision_override_ : precision;
 
-        int prec;
-        if (precision_override_ != 0)
+        if ((std::signbit)(val))
         {
-            prec = precision_override_;
+            writer.put('-');
+            val = -val;
         }
-        else if (precision != 0)
+        if (val == 0)
         {
-            prec = precision;
+            writer.put('0');
+            writer.put('.');
+            writer.put('0');
+            return;
         }
-        else
-        {
-            prec = std::numeric_limits<double>::digits10;
-        }             
 
-        int err = _ecvt_s(buf, _CVTBUFSIZE, val, prec, &decimal_point, &sign);
-        if (err != 0)
+        char digits[max_digits_length];
+        int length;
+        int exponent;
+        if (prec == 0)
         {
-            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Failed attempting double to string conversion"));
+            if (!grisu3(val, digits, &length, &exponent))
+            {
+                shortest_digits(val, digits, length, exponent);
+            }
+            prec = digits10;
         }
-        //std::cout << "prec:" << prec << ", buf:" << buf << std::endl;
-        char* s = buf;
-        char* se = s + prec;
-
-        int i, k;
-        int j;
-
-        if (sign)
+        else if (precision_override_ != 0 || prec > digits10 || val < (std::numeric_limits<double>::min)() ||
+                 !grisu3(val, digits, &length, &exponent) || length > prec)
         {
-            writer.put('-');
+            // A precision from the number_format is the number of digits the value was
+            // read with, so the shortest digits usually fit. For normal doubles and up to
+            // digits10 digits, rounding the shortest digits and rounding the value agree.
+            rounded_digits(val, prec, digits, length, exponent);
         }
-        if (decimal_point <= -4 || decimal_point > se - s + 5) 
+        while (length > 1 && digits[length-1] == '0')
         {
-            writer.put(*s++);
-            if (s < se) 
-            {
-                writer.put('.');
-                while ((se-1) > s && *(se-1) == '0')
-                {
-                    --se;
-                }
-
-                while(s < se)
-                {
-                    writer.put(*s++);
-                }
-            }
-            writer.put('e');
-            /* sprintf(b, "%+.2d", decimal_point - 1); */
-            if (--decimal_point < 0) {
-                writer.put('-');
-                decimal_point = -decimal_point;
-                }
-            else
-                writer.put('+');
-            for(j = 2, k = 10; 10*k <= decimal_point; j++, k *= 10);
-            for(;;) 
-            {
-                i = decimal_point / k;
-                writer.put(static_cast<char_type>(i) + '0');
-                if (--j <= 0)
-                    break;
-                decimal_point -= i*k;
-                decimal_point *= 10;
-            }
+            --length;
+            ++exponent;
         }
-        else if (decimal_point <= 0) 
+        print_digits(digits, length, exponent, prec, writer);
+    }
+private:
+    // digits holds val rounded to prec significant digits, val ~ digits * 10^exponent
+    static void rounded_digits(double val, int prec, char* digits, int& length, int& exponent)
+    {
+        char buf[max_digits_length + 16];
+        int n = snprintf(buf, sizeof(buf), "%.*e", prec-1, val);
+        if (n < 0 || n >= static_cast<int>(sizeof(buf)))
         {
-            writer.put('0');
-            writer.put('.');
-            while ((se-1) > s && *(se-1) == '0')
-            {
-                --se;
-            }
-            for(; decimal_point < 0; decimal_point++)
-            {
-                writer.put('0');
-            }
-            while(s < se)
-            {
-                writer.put(*s++);
-            }
+            JSONCONS_THROW(json_exception_impl<std::invalid_argument>("print_double failed."));
         }
-        else {
-            while(s < se) 
+        length = 0;
+        const char* p = buf;
+        for (; *p != 'e' && *p != 0; ++p)
+        {
+            if (*p >= '0' && *p <= '9')
             {
-                writer.put(*s++);
-                if ((--decimal_point == 0) && s < se)
-                {
-                    writer.put('.');
-                    while ((se-1) > s && *(se-1) == '0')
-                    {
-                        --se;
-                    }
-                }
+                digits[length++] = *p;
             }
-            for(; decimal_point > 0; decimal_point--)
+        }
+        exponent = (*p == 'e' ? std::atoi(p+1) : 0) - (length - 1);
+    }
+
+    // Grisu3 could not decide, take the first of 15, 16 or 17 digits that reads back
+    static void shortest_digits(double val, char* digits, int& length, int& exponent)
+    {
+        const int max_digits10 = std::numeric_limits<double>::max_digits10;
+        for (int prec = std::numeric_limits<double>::digits10; prec < max_digits10; ++prec)
+        {
+            rounded_digits(val, prec, digits, length, exponent);
+            if (reads_back(digits, length, exponent, val))
             {
-                writer.put('0');
+                return;
             }
         }
+        rounded_digits(val, max_digits10, digits, length, exponent);
     }
-};
 
-#elif defined(JSONCONS_NO_LOCALECONV)
-
-class print_double
-{
-private:
-    uint8_t precision_override_;
-    basic_obufferedstream<char> os_;
-public:
-    print_double(uint8_t precision)
-        : precision_override_(precision)
+    static bool reads_back(const char* digits, int length, int exponent, double val)
     {
-        os_.imbue(std::locale::classic());
-        os_.precision(precision);
+        char buf[40];
+        std::memcpy(buf, digits, length);
+        int n = snprintf(buf + length, sizeof(buf) - length, "e%d", exponent);
+        double d;
+        return n > 0 && decimal_to_double(buf, length + n, d) && d == val;
     }
 
     template <class Writer>
-    void operator()(double val, uint8_t precision, Writer& writer)
+    static void print_digits(const char* digits, int length, int exponent, int prec, Writer& writer)
     {
-        typedef typename Writer::char_type char_type;
-
-        int prec;
-        if (precision_override_ != 0)
-        {
-            prec = precision_override_;
-        }
-        else if (precision != 0)
-        {
-            prec = precision;
-        }
-        else
-        {
-            prec = std::numeric_limits<double>::digits10;
-        }             
-
-        os_.clear_sequence();
-        os_.precision(prec);
-        os_ << val;
-
-        //std::cout << "precision_override_:" << (int)precision_override_ << ", precision:" << (int)precision << ", buf:" << os_.data() << std::endl;
-
-        const char_type* sbeg = os_.data();
-        const char_type* send = sbeg + os_.length();
-        const char_type* pexp = send;
-
-        if (sbeg != send)
+        // Decimal exponent of the leading digit
+        int x = exponent + length - 1;
+        if (x < -4 || x >= prec)
         {
-            bool dot = false;
-            for (pexp = sbeg; *pexp != 'e' && *pexp != 'E' && pexp < send; ++pexp)
-            {
-            }
-
-            const char_type* qend = pexp;
-            while (qend >= sbeg+2 && *(qend-1) == '0' && *(qend-2) != '.')
+            writer.put(digits[0]);
+            writer.put('.');
+            if (length > 1)
             {
-                --qend;
+                for (int i = 1; i < length; ++i)
+                {
+                    writer.put(digits[i]);
+                }
             }
-            if (pexp == send)
+            else
             {
-                qend = ((qend >= sbeg+2) && *(qend-2) == '.') ? qend : send;
+                writer.put('0');
             }
-
-            for (const char_type* q = sbeg; q < qend; ++q)
+            writer.put('e');
+            if (x < 0)
             {
-                if (*q == '.')
-                {
-                    dot = true;
-                }
-                writer.put(*q);
+                writer.put('-');
+                x = -x;
             }
-            if (!dot)
+            else
             {
-                writer.put('.');
-                writer.put('0');
-                dot = true;
+                writer.put('+');
             }
-            for (const char_type* q = pexp; q < send; ++q)
+            if (x >= 100)
             {
-                writer.put(*q);
+                writer.put(static_cast<char>('0' + x / 100));
+                x %= 100;
             }
+            writer.put(static_cast<char>('0' + x / 10));
+            writer.put(static_cast<char>('0' + x % 10));
         }
-    }
-};
-#else
-
-class print_double
-{
-private:
-    uint8_t precision_override_;
-    char decimal_point_;
-public:
-    print_double(uint8_t precision)
-        : precision_override_(precision)
-    {
-        struct lconv * lc = localeconv();
-        if (lc != nullptr && lc->decimal_point[0] != 0)
-        {
-            decimal_point_ = lc->decimal_point[0];    
-        }
-        else
+        else if (x >= 0)
         {
-            decimal_point_ = '.'; 
-        }
-    }
-
-    template <class Writer>
-    void operator()(double val, uint8_t precision, Writer& writer)
-    {
-        typedef typename Writer::char_type char_type;
-
-        int prec;
-        if (precision_override_ != 0)
-        {
-            prec = precision_override_;
-        }
-        else if (precision != 0)
-        {
-            prec = precision;
-        }
-        else
-        {
-            prec = std::numeric_limits<double>::digits10;
-        }             
-
-        char number_buffer[100]; 
-        int length = snprintf(number_buffer, 100, "%1.*g", prec, val);
-        if (length < 0)
-        {
-            JSONCONS_THROW(json_exception_impl<std::invalid_argument>("print_double failed."));
-        }
-
-        const char* sbeg = number_buffer;
-        const char* send = sbeg + length;
-        const char* pexp = send;
-
-        if (sbeg != send)
-        {
-            bool dot = false;
-            for (pexp = sbeg; *pexp != 'e' && *pexp != 'E' && pexp < send; ++pexp)
+            int i = 0;
+            for (; i <= x; ++i)
             {
+                writer.put(i < length ? digits[i] : '0');
             }
-
-            for (const char* q = sbeg; q < pexp; ++q)
+            writer.put('.');
+            if (i < length)
             {
-                switch (*q)
+                for (; i < length; ++i)
                 {
-                case '-':case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
-                    writer.put(*q);
-                    break;
-                default:
-                    if (*q == decimal_point_)
-                    {
-                        dot = true;
-                        writer.put('.');
-                    }
-                    break;
+                    writer.put(digits[i]);
                 }
             }
-            if (!dot)
+            else
+            {
+                writer.put('0');
+            }
+        }
+        else
+        {
+            writer.put('0');
+            writer.put('.');
+            for (int i = -1; i > x; --i)
             {
-                writer.put('.');
                 writer.put('0');
-                dot = true;
             }
-            for (const char* q = pexp; q < send; ++q)
+            for (int i = 0; i < length; ++i)
             {
-                writer.put(*q);
+                writer.put(digits[i]);
             }
         }
     }
 };
 
-#endif
-
 }}
 
 #endif
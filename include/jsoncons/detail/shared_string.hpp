@@ -0,0 +1,270 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SHAREDSTRING_HPP
+#define JSONCONS_DETAIL_SHAREDSTRING_HPP
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/jsoncons_utilities.hpp>
+#include <jsoncons/detail/type_traits_helper.hpp>
+
+namespace jsoncons { namespace detail {
+
+// shared_string
+// An immutable, reference counted string. Copies share one allocation, and compare equal
+// without looking at the characters when they do. Used for object member names by
+// shared_keys_policy.
+
+template <class CharT, class Traits = std::char_traits<CharT>, class Allocator = std::allocator<CharT>>
+class shared_string
+{
+public:
+    typedef CharT value_type;
+    typedef Traits traits_type;
+    typedef Allocator allocator_type;
+    typedef size_t size_type;
+    typedef const CharT* const_iterator;
+    typedef const CharT* iterator;
+    typedef basic_string_view_ext<CharT,Traits> string_view_type;
+private:
+    struct header
+    {
+        std::atomic<size_t> count_;
+        size_t length_;
+    };
+
+    // Storage is allocated in units aligned for the header
+    typedef typename std::aligned_storage<sizeof(header),alignof(header)>::type unit_type;
+    typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<unit_type> unit_allocator_type;
+
+    static const size_t header_size = sizeof(unit_type);
+
+    header* ptr_;
+    allocator_type allocator_;
+
+    static size_t storage_size(size_t length)
+    {
+        return (header_size + (length + 1)*sizeof(CharT) + sizeof(unit_type) - 1)/sizeof(unit_type);
+    }
+
+    CharT* chars() const
+    {
+        return reinterpret_cast<CharT*>(reinterpret_cast<char*>(ptr_) + header_size);
+    }
+
+    template <class InputIt>
+    void create(InputIt first, InputIt last)
+    {
+        const size_t length = static_cast<size_t>(std::distance(first, last));
+        if (length == 0)
+        {
+            ptr_ = nullptr;
+            return;
+        }
+        unit_allocator_type alloc(allocator_);
+        unit_type* p = detail::to_plain_pointer(alloc.allocate(storage_size(length)));
+        ptr_ = ::new(static_cast<void*>(p)) header();
+        ptr_->count_ = 1;
+        ptr_->length_ = length;
+        CharT* s = chars();
+        for (size_t i = 0; first != last; ++first, ++i)
+        {
+            s[i] = *first;
+        }
+        s[length] = CharT();
+    }
+
+    void release()
+    {
+        if (ptr_ != nullptr && --ptr_->count_ == 0)
+        {
+            const size_t size = storage_size(ptr_->length_);
+            ptr_->~header();
+            unit_allocator_type alloc(allocator_);
+            alloc.deallocate(reinterpret_cast<unit_type*>(ptr_), size);
+        }
+        ptr_ = nullptr;
+    }
+public:
+    shared_string()
+        : ptr_(nullptr), allocator_()
+    {
+    }
+
+    explicit shared_string(const allocator_type& allocator)
+        : ptr_(nullptr), allocator_(allocator)
+    {
+    }
+
+    template <class InputIt>
+    shared_string(InputIt first, InputIt last, const allocator_type& allocator = allocator_type())
+        : ptr_(nullptr), allocator_(allocator)
+    {
+        create(first, last);
+    }
+
+    shared_string(const CharT* s, size_t length, const allocator_type& allocator = allocator_type())
+        : ptr_(nullptr), allocator_(allocator)
+    {
+        create(s, s + length);
+    }
+
+    shared_string(const shared_string& other)
+        : ptr_(other.ptr_), allocator_(other.allocator_)
+    {
+        if (ptr_ != nullptr)
+        {
+            ++ptr_->count_;
+        }
+    }
+
+    shared_string(shared_string&& other) JSONCONS_NOEXCEPT
+        : ptr_(other.ptr_), allocator_(other.allocator_)
+    {
+        other.ptr_ = nullptr;
+    }
+
+    ~shared_string()
+    {
+        release();
+    }
+
+    shared_string& operator=(const shared_string& other)
+    {
+        if (ptr_ != other.ptr_)
+        {
+            shared_string tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    shared_string& operator=(shared_string&& other) JSONCONS_NOEXCEPT
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(shared_string& other) JSONCONS_NOEXCEPT
+    {
+        std::swap(ptr_, other.ptr_);
+        std::swap(allocator_, other.allocator_);
+    }
+
+    const CharT* data() const
+    {
+        static const CharT empty[1] = {CharT()};
+        return ptr_ != nullptr ? chars() : empty;
+    }
+
+    const CharT* c_str() const
+    {
+        return data();
+    }
+
+    size_t size() const
+    {
+        return ptr_ != nullptr ? ptr_->length_ : 0;
+    }
+
+    size_t length() const
+    {
+        return size();
+    }
+
+    bool empty() const
+    {
+        return ptr_ == nullptr;
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator end() const
+    {
+        return data() + size();
+    }
+
+    // The number of shared_string objects that share this one's characters
+    size_t use_count() const
+    {
+        return ptr_ != nullptr ? ptr_->count_.load() : 0;
+    }
+
+    allocator_type get_allocator() const
+    {
+        return allocator_;
+    }
+
+    void shrink_to_fit()
+    {
+    }
+
+    operator string_view_type() const
+    {
+        return string_view_type(data(), size());
+    }
+
+    int compare(const shared_string& other) const
+    {
+        return ptr_ == other.ptr_ ? 0 : string_view_type(*this).compare(string_view_type(other));
+    }
+
+    friend bool operator==(const shared_string& lhs, const shared_string& rhs)
+    {
+        return lhs.ptr_ == rhs.ptr_ || string_view_type(lhs) == string_view_type(rhs);
+    }
+
+    friend bool operator!=(const shared_string& lhs, const shared_string& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const shared_string& lhs, const shared_string& rhs)
+    {
+        return lhs.compare(rhs) < 0;
+    }
+
+    friend bool operator==(const shared_string& lhs, const string_view_type& rhs)
+    {
+        return string_view_type(lhs) == rhs;
+    }
+
+    friend bool operator==(const string_view_type& lhs, const shared_string& rhs)
+    {
+        return lhs == string_view_type(rhs);
+    }
+
+    friend bool operator!=(const shared_string& lhs, const string_view_type& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator!=(const string_view_type& lhs, const shared_string& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const shared_string& s)
+    {
+        os.write(s.data(), s.size());
+        return os;
+    }
+};
+
+}}
+
+#endif
@@ -0,0 +1,233 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_STRUCTURALINDEX_HPP
+#define JSONCONS_DETAIL_STRUCTURALINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/detail/char_scanners.hpp>
+
+namespace jsoncons { namespace detail {
+
+// Stage one of the structural index parser, after Langdale and Lemire, "Parsing Gigabytes
+// of JSON per Second". The input is classified 64 characters at a time into bit masks,
+// string interiors are masked out, and the positions of the structural characters
+// {}[]:, of the opening quotes of strings, and of the first character of every other
+// token (numbers, literals, anything unexpected) are written to the index. The index
+// only locates tokens, the second stage validates them.
+
+struct char_class_masks
+{
+    uint64_t backslash;
+    uint64_t quote;
+    uint64_t whitespace;
+    uint64_t op;
+    uint64_t non_ascii;
+};
+
+template <class CharT>
+char_class_masks classify_block(const CharT* p)
+{
+    typedef typename std::make_unsigned<CharT>::type uchar_type;
+
+    char_class_masks masks = {0,0,0,0,0};
+    for (size_t i = 0; i < 64; ++i)
+    {
+        uint64_t bit = uint64_t(1) << i;
+        if (static_cast<uchar_type>(p[i]) >= 0x80)
+        {
+            masks.non_ascii |= bit;
+        }
+        switch (p[i])
+        {
+            case '\\':
+                masks.backslash |= bit;
+                break;
+            case '\"':
+                masks.quote |= bit;
+                break;
+            case ' ':case '\t':case '\n':case '\r':
+                masks.whitespace |= bit;
+                break;
+            case '{':case '}':case '[':case ']':case ':':case ',':
+                masks.op |= bit;
+                break;
+            default:
+                break;
+        }
+    }
+    return masks;
+}
+
+#if defined(JSONCONS_HAS_SSE2)
+
+inline uint64_t movemask_64(__m128i v0, __m128i v1, __m128i v2, __m128i v3)
+{
+    return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(v0)) & 0xffff)
+        | (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(v1)) & 0xffff) << 16)
+        | (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(v2)) & 0xffff) << 32)
+        | (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(v3)) & 0xffff) << 48);
+}
+
+inline __m128i is_whitespace_sse2(__m128i v)
+{
+    return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+}
+
+inline __m128i is_op_sse2(__m128i v)
+{
+    // '[' and ']' differ from '{' and '}' only in bit 0x20
+    __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+                        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+}
+
+inline char_class_masks classify_block(const char* p)
+{
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+    __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32));
+    __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48));
+
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i quote = _mm_set1_epi8('\"');
+
+    char_class_masks masks;
+    masks.backslash = movemask_64(_mm_cmpeq_epi8(v0, backslash), _mm_cmpeq_epi8(v1, backslash),
+                                  _mm_cmpeq_epi8(v2, backslash), _mm_cmpeq_epi8(v3, backslash));
+    masks.quote = movemask_64(_mm_cmpeq_epi8(v0, quote), _mm_cmpeq_epi8(v1, quote),
+                              _mm_cmpeq_epi8(v2, quote), _mm_cmpeq_epi8(v3, quote));
+    masks.whitespace = movemask_64(is_whitespace_sse2(v0), is_whitespace_sse2(v1),
+                                   is_whitespace_sse2(v2), is_whitespace_sse2(v3));
+    masks.op = movemask_64(is_op_sse2(v0), is_op_sse2(v1), is_op_sse2(v2), is_op_sse2(v3));
+    masks.non_ascii = movemask_64(v0, v1, v2, v3);
+    return masks;
+}
+
+#endif
+
+// prefix_xor
+// Bit i of the result is the xor of bits 0 through i of mask
+
+inline uint64_t prefix_xor(uint64_t mask)
+{
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+}
+
+class structural_indexer
+{
+    uint64_t prev_escaped_;
+    uint64_t prev_in_string_;
+    uint64_t prev_separator_;
+    uint64_t non_ascii_;
+public:
+    structural_indexer()
+        : prev_escaped_(0), prev_in_string_(0), prev_separator_(1), non_ascii_(0)
+    {
+    }
+
+    bool in_string() const
+    {
+        return prev_in_string_ != 0;
+    }
+
+    bool is_ascii() const
+    {
+        return non_ascii_ == 0;
+    }
+
+    template <class Index>
+    void index_block(const char_class_masks& masks, uint32_t offset, Index& index)
+    {
+        non_ascii_ |= masks.non_ascii;
+
+        uint64_t escaped = find_escaped(masks.backslash);
+        uint64_t quote = masks.quote & ~escaped;
+        uint64_t in_string = prefix_xor(quote) ^ prev_in_string_;
+        prev_in_string_ = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+        // Opening quotes are inside the string mask, closing quotes are not
+        uint64_t op = masks.op & ~in_string;
+        uint64_t separator = op | (masks.whitespace & ~in_string) | quote;
+        uint64_t follows_separator = (separator << 1) | prev_separator_;
+        prev_separator_ = separator >> 63;
+        uint64_t token_start = follows_separator & ~(masks.op | masks.whitespace | quote | in_string);
+
+        uint64_t structurals = op | (quote & in_string) | token_start;
+        while (structurals != 0)
+        {
+            index.push_back(offset + count_trailing_zeros(structurals));
+            structurals &= structurals - 1;
+        }
+    }
+private:
+    // Characters preceded by an odd length run of backslashes are escaped
+    uint64_t find_escaped(uint64_t backslash)
+    {
+        const uint64_t even_bits = 0x5555555555555555ULL;
+
+        backslash &= ~prev_escaped_;
+        uint64_t follows_escape = (backslash << 1) | prev_escaped_;
+        uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+        uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+        prev_escaped_ = sequences_starting_on_even_bits < backslash ? 1 : 0;
+        uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+        return (even_bits ^ invert_mask) & follows_escape;
+    }
+};
+
+struct structural_index_result
+{
+    bool in_string;
+    bool is_ascii;
+};
+
+// build_structural_index
+// Appends the positions of the tokens in [data,data+length) to index, length must not
+// exceed the range of uint32_t. Also reports whether the input ends inside a string,
+// and whether it is all ASCII, in which case strings need no UTF-8 validation.
+
+template <class CharT, class Index>
+structural_index_result build_structural_index(const CharT* data, size_t length, Index& index)
+{
+    structural_indexer indexer;
+
+    size_t offset = 0;
+    for (; length - offset >= 64; offset += 64)
+    {
+        indexer.index_block(classify_block(data + offset), static_cast<uint32_t>(offset), index);
+    }
+    if (offset < length)
+    {
+        CharT tail[64];
+        size_t i = 0;
+        for (; i < length - offset; ++i)
+        {
+            tail[i] = data[offset + i];
+        }
+        for (; i < 64; ++i)
+        {
+            tail[i] = ' ';
+        }
+        indexer.index_block(classify_block(static_cast<const CharT*>(tail)), static_cast<uint32_t>(offset), index);
+    }
+    structural_index_result result = {indexer.in_string(), indexer.is_ascii()};
+    return result;
+}
+
+}}
+
+#endif
@@ -27,9 +27,12 @@
 #include <jsoncons/json_serializer.hpp>
 #include <jsoncons/json_decoder.hpp>
 #include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_index_parser.hpp>
 #include <jsoncons/json_type_traits.hpp>
 #include <jsoncons/json_error_category.hpp>
 #include <jsoncons/detail/heap_only_string.hpp>
+#include <jsoncons/detail/shared_string.hpp>
+#include <jsoncons/detail/counted_node.hpp>
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -62,6 +65,33 @@ struct preserve_order_policy : public sorted_policy
     static const bool preserve_order = true;
 };
 
+// Object member names are immutable, reference counted strings, and copies of a name share
+// its characters. json_decoder with intern_keys set gives repeated names a single copy.
+template <class Policy = sorted_policy>
+struct shared_keys_policy : public Policy
+{
+    template <class CharT, class CharTraits, class Allocator>
+    using key_storage = detail::shared_string<CharT, CharTraits, Allocator>;
+};
+
+// Arrays and objects are reference counted and shared by copies, a copy is made of one only
+// when a value that shares it is about to change it.
+template <class Policy = sorted_policy>
+struct copy_on_write_policy : public Policy
+{
+    static const bool copy_on_write = true;
+};
+
+namespace detail {
+
+template <class Policy, class Enable = void>
+struct is_copy_on_write : std::false_type {};
+
+template <class Policy>
+struct is_copy_on_write<Policy, typename std::enable_if<Policy::copy_on_write>::type> : std::true_type {};
+
+}
+
 template <typename IteratorT>
 class range 
 {
@@ -92,8 +122,11 @@ enum class json_type_tag : uint8_t
     integer_t,
     uinteger_t,
     double_t,
+    small_number_text_t,
+    number_text_t,
     small_string_t,
     string_t,
+    string_view_t,
     byte_string_t,
     array_t,
     object_t
@@ -110,6 +143,8 @@ public:
 
     typedef typename ImplementationPolicy::parse_error_handler_type parse_error_handler_type;
 
+    static const bool copy_on_write = detail::is_copy_on_write<ImplementationPolicy>::value;
+
     typedef CharT char_type;
     typedef typename std::char_traits<char_type> char_traits_type;
 
@@ -256,6 +291,7 @@ public:
         public:
             double_data(double val)
                 : data_base(json_type_tag::double_t), 
+                  format_(chars_format::general), 
                   precision_(0), 
                   decimal_places_(0), 
                   val_(val)
@@ -272,6 +308,7 @@ public:
 
             double_data(const double_data& val)
                 : data_base(json_type_tag::double_t),
+                  format_(val.format_), 
                   precision_(val.precision_), 
                   decimal_places_(val.decimal_places_), 
                   val_(val.val_)
@@ -290,36 +327,40 @@ public:
 
             uint8_t decimal_places() const
             {
-                return precision_;
+                return decimal_places_;
             }
         };
 
+        // small_string_data
+        // Characters are stored inline, in all of the value's storage after the type tag. The
+        // last character slot holds the number of unused slots before it, so that when the
+        // string fills the buffer that count is zero and doubles as the null terminator.
+        // With tag small_number_text_t, the characters are a number token.
         class small_string_data final : public data_base
         {
-            static const size_t capacity = 14/sizeof(char_type);
-            uint8_t length_;
+            static const size_t capacity = (sizeof(double_data) - sizeof(data_base)) / sizeof(char_type);
             char_type data_[capacity];
         public:
-            static const size_t max_length = (14 / sizeof(char_type)) - 1;
+            static const size_t max_length = capacity - 1;
 
-            small_string_data(const char_type* p, uint8_t length)
-                : data_base(json_type_tag::small_string_t), length_(length)
+            small_string_data(const char_type* p, uint8_t length, json_type_tag tag = json_type_tag::small_string_t)
+                : data_base(tag)
             {
                 JSONCONS_ASSERT(length <= max_length);
                 std::memcpy(data_,p,length*sizeof(char_type));
                 data_[length] = 0;
+                data_[max_length] = static_cast<char_type>(max_length - length);
             }
 
             small_string_data(const small_string_data& val)
-                : data_base(json_type_tag::small_string_t), length_(val.length_)
+                : data_base(val.type_id_)
             {
-                std::memcpy(data_,val.data_,val.length_*sizeof(char_type));
-                data_[length_] = 0;
+                std::memcpy(data_,val.data_,capacity*sizeof(char_type));
             }
 
             uint8_t length() const
             {
-                return length_;
+                return static_cast<uint8_t>(max_length - static_cast<size_t>(data_[max_length]));
             }
 
             const char_type* data() const
@@ -334,6 +375,7 @@ public:
         };
 
         // string_data
+        // With tag number_text_t, the characters are a number token
         class string_data final : public data_base
         {
             typedef typename detail::heap_only_string_factory<char_type, Allocator>::string_pointer pointer;
@@ -341,25 +383,25 @@ public:
             pointer ptr_;
         public:
             string_data(const string_data& val)
-                : data_base(json_type_tag::string_t)
+                : data_base(val.type_id_)
             {
                 ptr_ = detail::heap_only_string_factory<char_type,Allocator>::create(val.data(),val.length(),val.get_allocator());
             }
 
             string_data(string_data&& val)
-                : data_base(json_type_tag::string_t), ptr_(nullptr)
+                : data_base(val.type_id_), ptr_(nullptr)
             {
                 std::swap(val.ptr_,ptr_);
             }
 
             string_data(const string_data& val, const Allocator& a)
-                : data_base(json_type_tag::string_t)
+                : data_base(val.type_id_)
             {
                 ptr_ = detail::heap_only_string_factory<char_type,Allocator>::create(val.data(),val.length(),a);
             }
 
-            string_data(const char_type* data, size_t length, const Allocator& a)
-                : data_base(json_type_tag::string_t)
+            string_data(const char_type* data, size_t length, const Allocator& a, json_type_tag tag = json_type_tag::string_t)
+                : data_base(tag)
             {
                 ptr_ = detail::heap_only_string_factory<char_type,Allocator>::create(data,length,a);
             }
@@ -374,6 +416,7 @@ public:
 
             void swap(string_data& val)
             {
+                std::swap(val.type_id_,this->type_id_);
                 std::swap(val.ptr_,ptr_);
             }
 
@@ -398,6 +441,43 @@ public:
             }
         };
 
+        // string_view_data
+        // Refers to characters owned by someone else, such as a buffer parsed in situ.
+        // The characters must outlive the value, and must be null terminated for as_cstring.
+        class string_view_data final : public data_base
+        {
+            uint32_t length_;
+            const char_type* data_;
+        public:
+            static const size_t max_length = (std::numeric_limits<uint32_t>::max)();
+
+            string_view_data(const char_type* data, size_t length)
+                : data_base(json_type_tag::string_view_t), length_(static_cast<uint32_t>(length)), data_(data)
+            {
+                JSONCONS_ASSERT(length <= max_length);
+            }
+
+            string_view_data(const string_view_data& val)
+                : data_base(json_type_tag::string_view_t), length_(val.length_), data_(val.data_)
+            {
+            }
+
+            const char_type* data() const
+            {
+                return data_;
+            }
+
+            const char_type* c_str() const
+            {
+                return data_;
+            }
+
+            size_t length() const
+            {
+                return length_;
+            }
+        };
+
         // byte_string_data
         class byte_string_data final : public data_base
         {
@@ -478,43 +558,68 @@ public:
         };
 
         // array_data
+        // With a copy_on_write policy, copies share the array until one of them is changed
         class array_data final : public data_base
         {
-            typedef typename std::allocator_traits<array_allocator>::pointer pointer;
+            typedef detail::counted_node<array,copy_on_write> node_type;
+            typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<node_type> node_allocator_type;
+            typedef typename std::allocator_traits<node_allocator_type>::pointer pointer;
             pointer ptr_;
 
             template <typename... Args>
-            void create(array_allocator allocator, Args&& ... args)
+            static pointer create(const Allocator& allocator, Args&& ... args)
             {
-                typename std::allocator_traits<Allocator>:: template rebind_alloc<array> alloc(allocator);
-                ptr_ = alloc.allocate(1);
+                node_allocator_type alloc(allocator);
+                pointer ptr = alloc.allocate(1);
                 try
                 {
-                    std::allocator_traits<array_allocator>:: template rebind_traits<array>::construct(alloc, detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+                    std::allocator_traits<node_allocator_type>::construct(alloc, detail::to_plain_pointer(ptr), std::forward<Args>(args)...);
                 }
                 catch (...)
                 {
-                    alloc.deallocate(ptr_,1);
+                    alloc.deallocate(ptr,1);
                     throw;
                 }
+                return ptr;
+            }
+
+            static void release(pointer ptr)
+            {
+                if (ptr != nullptr && ptr->release())
+                {
+                    node_allocator_type alloc(ptr->value().get_allocator());
+                    std::allocator_traits<node_allocator_type>::destroy(alloc, detail::to_plain_pointer(ptr));
+                    alloc.deallocate(ptr,1);
+                }
             }
         public:
             array_data(const array& val)
-                : data_base(json_type_tag::array_t)
+                : data_base(json_type_tag::array_t), ptr_(create(val.get_allocator(), val))
             {
-                create(val.get_allocator(), val);
             }
 
             array_data(const array& val, const Allocator& a)
-                : data_base(json_type_tag::array_t)
+                : data_base(json_type_tag::array_t), ptr_(create(a, val, a))
+            {
+            }
+
+            array_data(array&& val)
+                : data_base(json_type_tag::array_t), ptr_(create(val.get_allocator(), std::move(val)))
             {
-                create(array_allocator(a), val, a);
             }
 
             array_data(const array_data& val)
                 : data_base(json_type_tag::array_t)
             {
-                create(val.ptr_->get_allocator(), *(val.ptr_));
+                if (copy_on_write)
+                {
+                    ptr_ = val.ptr_;
+                    ptr_->add_ref();
+                }
+                else
+                {
+                    ptr_ = create(val.get_allocator(), val.ptr_->value());
+                }
             }
 
             array_data(array_data&& val)
@@ -524,23 +629,18 @@ public:
             }
 
             array_data(const array_data& val, const Allocator& a)
-                : data_base(json_type_tag::array_t)
+                : data_base(json_type_tag::array_t), ptr_(create(a, val.ptr_->value(), a))
             {
-                create(array_allocator(a), *(val.ptr_), a);
             }
+
             ~array_data()
             {
-                if (ptr_ != nullptr)
-                {
-                    typename std::allocator_traits<array_allocator>:: template rebind_alloc<array> alloc(ptr_->get_allocator());
-                    std::allocator_traits<array_allocator>:: template rebind_traits<array>::destroy(alloc, detail::to_plain_pointer(ptr_));
-                    alloc.deallocate(ptr_,1);
-                }
+                release(ptr_);
             }
 
             allocator_type get_allocator() const
             {
-                return ptr_->get_allocator();
+                return ptr_->value().get_allocator();
             }
 
             void swap(array_data& val)
@@ -548,61 +648,97 @@ public:
                 std::swap(val.ptr_,ptr_);
             }
 
+            // Gives this value its own copy of a shared array first
             array& value()
             {
-                return *ptr_;
+                if (ptr_->is_shared())
+                {
+                    pointer ptr = create(get_allocator(), ptr_->value());
+                    release(ptr_);
+                    ptr_ = ptr;
+                }
+                return ptr_->value();
             }
 
             const array& value() const
             {
-                return *ptr_;
+                return ptr_->value();
+            }
+
+            bool is_shared() const
+            {
+                return ptr_->is_shared();
             }
         };
 
         // object_data
+        // With a copy_on_write policy, copies share the object until one of them is changed
         class object_data final : public data_base
         {
-            typedef typename std::allocator_traits<object_allocator>::pointer pointer;
+            typedef detail::counted_node<object,copy_on_write> node_type;
+            typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<node_type> node_allocator_type;
+            typedef typename std::allocator_traits<node_allocator_type>::pointer pointer;
             pointer ptr_;
 
             template <typename... Args>
-            void create(Allocator allocator, Args&& ... args)
+            static pointer create(const Allocator& allocator, Args&& ... args)
             {
-                typename std::allocator_traits<object_allocator>:: template rebind_alloc<object> alloc(allocator);
-                ptr_ = alloc.allocate(1);
+                node_allocator_type alloc(allocator);
+                pointer ptr = alloc.allocate(1);
                 try
                 {
-                    std::allocator_traits<object_allocator>:: template rebind_traits<object>::construct(alloc, detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+                    std::allocator_traits<node_allocator_type>::construct(alloc, detail::to_plain_pointer(ptr), std::forward<Args>(args)...);
                 }
                 catch (...)
                 {
-                    alloc.deallocate(ptr_,1);
+                    alloc.deallocate(ptr,1);
                     throw;
                 }
+                return ptr;
+            }
+
+            static void release(pointer ptr)
+            {
+                if (ptr != nullptr && ptr->release())
+                {
+                    node_allocator_type alloc(ptr->value().get_allocator());
+                    std::allocator_traits<node_allocator_type>::destroy(alloc, detail::to_plain_pointer(ptr));
+                    alloc.deallocate(ptr,1);
+                }
             }
         public:
             explicit object_data(const Allocator& a)
-                : data_base(json_type_tag::object_t)
+                : data_base(json_type_tag::object_t), ptr_(create(a,a))
             {
-                create(a,a);
             }
 
             explicit object_data(const object& val)
-                : data_base(json_type_tag::object_t)
+                : data_base(json_type_tag::object_t), ptr_(create(val.get_allocator(), val))
             {
-                create(val.get_allocator(), val);
             }
 
             explicit object_data(const object& val, const Allocator& a)
-                : data_base(json_type_tag::object_t)
+                : data_base(json_type_tag::object_t), ptr_(create(a, val, a))
+            {
+            }
+
+            explicit object_data(object&& val)
+                : data_base(json_type_tag::object_t), ptr_(create(val.get_allocator(), std::move(val)))
             {
-                create(object_allocator(a), val, a);
             }
 
             explicit object_data(const object_data& val)
                 : data_base(json_type_tag::object_t)
             {
-                create(val.ptr_->get_allocator(), *(val.ptr_));
+                if (copy_on_write)
+                {
+                    ptr_ = val.ptr_;
+                    ptr_->add_ref();
+                }
+                else
+                {
+                    ptr_ = create(val.get_allocator(), val.ptr_->value());
+                }
             }
 
             explicit object_data(object_data&& val)
@@ -612,19 +748,13 @@ public:
             }
 
             explicit object_data(const object_data& val, const Allocator& a)
-                : data_base(json_type_tag::object_t)
+                : data_base(json_type_tag::object_t), ptr_(create(a, val.ptr_->value(), a))
             {
-                create(object_allocator(a), *(val.ptr_), a);
             }
 
             ~object_data()
             {
-                if (ptr_ != nullptr)
-                {
-                    typename std::allocator_traits<Allocator>:: template rebind_alloc<object> alloc(ptr_->get_allocator());
-                    std::allocator_traits<Allocator>:: template rebind_traits<object>::destroy(alloc, detail::to_plain_pointer(ptr_));
-                    alloc.deallocate(ptr_,1);
-                }
+                release(ptr_);
             }
 
             void swap(object_data& val)
@@ -632,25 +762,37 @@ public:
                 std::swap(val.ptr_,ptr_);
             }
 
+            // Gives this value its own copy of a shared object first
             object& value()
             {
-                return *ptr_;
+                if (ptr_->is_shared())
+                {
+                    pointer ptr = create(get_allocator(), ptr_->value());
+                    release(ptr_);
+                    ptr_ = ptr;
+                }
+                return ptr_->value();
             }
 
             const object& value() const
             {
-                return *ptr_;
+                return ptr_->value();
+            }
+
+            bool is_shared() const
+            {
+                return ptr_->is_shared();
             }
 
             allocator_type get_allocator() const
             {
-                return ptr_->get_allocator();
+                return ptr_->value().get_allocator();
             }
         };
 
     private:
-        static const size_t data_size = static_max<sizeof(uinteger_data),sizeof(double_data),sizeof(small_string_data), sizeof(string_data), sizeof(array_data), sizeof(object_data)>::value;
-        static const size_t data_align = static_max<JSONCONS_ALIGNOF(uinteger_data),JSONCONS_ALIGNOF(double_data),JSONCONS_ALIGNOF(small_string_data),JSONCONS_ALIGNOF(string_data),JSONCONS_ALIGNOF(array_data),JSONCONS_ALIGNOF(object_data)>::value;
+        static const size_t data_size = static_max<sizeof(uinteger_data),sizeof(double_data),sizeof(small_string_data), sizeof(string_data), sizeof(string_view_data), sizeof(array_data), sizeof(object_data)>::value;
+        static const size_t data_align = static_max<JSONCONS_ALIGNOF(uinteger_data),JSONCONS_ALIGNOF(double_data),JSONCONS_ALIGNOF(small_string_data),JSONCONS_ALIGNOF(string_data),JSONCONS_ALIGNOF(string_view_data),JSONCONS_ALIGNOF(array_data),JSONCONS_ALIGNOF(object_data)>::value;
 
         typedef typename std::aligned_storage<data_size,data_align>::type data_t;
 
@@ -726,6 +868,18 @@ public:
                 new(reinterpret_cast<void*>(&data_))string_data(s, length, char_allocator_type());
             }
         }
+        variant(const string_view_data& val)
+        {
+            new(reinterpret_cast<void*>(&data_))string_view_data(val);
+        }
+        variant(const small_string_data& val)
+        {
+            new(reinterpret_cast<void*>(&data_))small_string_data(val);
+        }
+        variant(string_data&& val)
+        {
+            new(reinterpret_cast<void*>(&data_))string_data(std::move(val));
+        }
         variant(const uint8_t* s, size_t length)
         {
             new(reinterpret_cast<void*>(&data_))byte_string_data(s, length, byte_allocator_type());
@@ -781,6 +935,10 @@ public:
         {
             new(reinterpret_cast<void*>(&data_))object_data(val, alloc);
         }
+        variant(object&& val)
+        {
+            new(reinterpret_cast<void*>(&data_))object_data(std::move(val));
+        }
         variant(const array& val)
         {
             new(reinterpret_cast<void*>(&data_))array_data(val);
@@ -789,6 +947,10 @@ public:
         {
             new(reinterpret_cast<void*>(&data_))array_data(val,alloc);
         }
+        variant(array&& val)
+        {
+            new(reinterpret_cast<void*>(&data_))array_data(std::move(val));
+        }
 
         ~variant()
         {
@@ -800,22 +962,91 @@ public:
             switch (type_id())
             {
             case json_type_tag::string_t:
+            case json_type_tag::number_text_t:
                 reinterpret_cast<string_data*>(&data_)->~string_data();
                 break;
             case json_type_tag::byte_string_t:
                 reinterpret_cast<byte_string_data*>(&data_)->~byte_string_data();
                 break;
             case json_type_tag::object_t:
-                reinterpret_cast<object_data*>(&data_)->~object_data();
-                break;
             case json_type_tag::array_t:
-                reinterpret_cast<array_data*>(&data_)->~array_data();
+                Destroy_container_();
                 break;
             default:
                 break;
             }
         }
 
+        // Destroys an array or object without recursing through the arrays and objects
+        // nested in it. Those are moved onto an explicit stack, and each is emptied of its
+        // own before it is destroyed, so the depth of a document does not reach the call stack.
+        // An array or object that is shared with another value is only released.
+        void Destroy_container_()
+        {
+            std::vector<basic_json> stack;
+            Take_nested_containers_(stack);
+            Destroy_shallow_();
+            while (!stack.empty())
+            {
+                basic_json current(std::move(stack.back()));
+                stack.pop_back();
+                current.var_.Take_nested_containers_(stack);
+                current.var_.Destroy_shallow_();
+                new(reinterpret_cast<void*>(&current.var_.data_))null_data();
+            }
+        }
+
+        void Destroy_shallow_()
+        {
+            if (type_id() == json_type_tag::object_t)
+            {
+                reinterpret_cast<object_data*>(&data_)->~object_data();
+            }
+            else
+            {
+                reinterpret_cast<array_data*>(&data_)->~array_data();
+            }
+        }
+
+        // If an allocation fails, the containers that were not moved are destroyed recursively
+        void Take_nested_containers_(std::vector<basic_json>& stack) JSONCONS_NOEXCEPT
+        {
+            try
+            {
+                if (type_id() == json_type_tag::array_t)
+                {
+                    if (!array_data_cast()->is_shared())
+                    {
+                        for (auto& element : array_data_cast()->value())
+                        {
+                            if (element.var_.is_container_())
+                            {
+                                stack.push_back(std::move(element));
+                            }
+                        }
+                    }
+                }
+                else if (!object_data_cast()->is_shared())
+                {
+                    for (auto& member : object_data_cast()->value())
+                    {
+                        if (member.value().var_.is_container_())
+                        {
+                            stack.push_back(std::move(member.value()));
+                        }
+                    }
+                }
+            }
+            catch (...)
+            {
+            }
+        }
+
+        bool is_container_() const
+        {
+            return type_id() == json_type_tag::array_t || type_id() == json_type_tag::object_t;
+        }
+
         variant& operator=(const variant& val)
         {
             if (this !=&val)
@@ -842,11 +1073,16 @@ public:
                     new(reinterpret_cast<void*>(&data_))double_data(*(val.double_data_cast()));
                     break;
                 case json_type_tag::small_string_t:
+                case json_type_tag::small_number_text_t:
                     new(reinterpret_cast<void*>(&data_))small_string_data(*(val.small_string_data_cast()));
                     break;
                 case json_type_tag::string_t:
+                case json_type_tag::number_text_t:
                     new(reinterpret_cast<void*>(&data_))string_data(*(val.string_data_cast()));
                     break;
+                case json_type_tag::string_view_t:
+                    Init_string_(val.string_view_data_cast()->data(), val.string_view_data_cast()->length(), Allocator());
+                    break;
                 case json_type_tag::byte_string_t:
                     new(reinterpret_cast<void*>(&data_))byte_string_data(*(val.byte_string_data_cast()));
                     break;
@@ -913,6 +1149,11 @@ public:
             return reinterpret_cast<const small_string_data*>(&data_);
         }
 
+        const string_view_data* string_view_data_cast() const
+        {
+            return reinterpret_cast<const string_view_data*>(&data_);
+        }
+
         string_data* string_data_cast()
         {
             return reinterpret_cast<string_data*>(&data_);
@@ -961,11 +1202,33 @@ public:
                 return string_view_type(small_string_data_cast()->data(),small_string_data_cast()->length());
             case json_type_tag::string_t:
                 return string_view_type(string_data_cast()->data(),string_data_cast()->length());
+            case json_type_tag::string_view_t:
+                return string_view_type(string_view_data_cast()->data(),string_view_data_cast()->length());
             default:
                 JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a string"));
             }
         }
 
+        // The token of a number kept as text
+        string_view_type as_number_text() const
+        {
+            switch (type_id())
+            {
+            case json_type_tag::small_number_text_t:
+                return string_view_type(small_string_data_cast()->data(),small_string_data_cast()->length());
+            case json_type_tag::number_text_t:
+                return string_view_type(string_data_cast()->data(),string_data_cast()->length());
+            default:
+                JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a number token"));
+            }
+        }
+
+        double number_text_value() const
+        {
+            string_view_type s = as_number_text();
+            return detail::number_text_to_double(s.data(), s.length());
+        }
+
         byte_string_view as_byte_string_view() const
         {
             switch (type_id())
@@ -1023,6 +1286,9 @@ public:
                     return integer_data_cast()->value() >= 0 ? static_cast<uint64_t>(integer_data_cast()->value()) == rhs.uinteger_data_cast()->value() : false;
                 case json_type_tag::double_t:
                     return static_cast<double>(integer_data_cast()->value()) == rhs.double_data_cast()->value();
+                case json_type_tag::small_number_text_t:
+                case json_type_tag::number_text_t:
+                    return static_cast<double>(integer_data_cast()->value()) == rhs.number_text_value();
                 default:
                     return false;
                 }
@@ -1036,6 +1302,9 @@ public:
                     return uinteger_data_cast()->value() == rhs.uinteger_data_cast()->value();
                 case json_type_tag::double_t:
                     return static_cast<double>(uinteger_data_cast()->value()) == rhs.double_data_cast()->value();
+                case json_type_tag::small_number_text_t:
+                case json_type_tag::number_text_t:
+                    return static_cast<double>(uinteger_data_cast()->value()) == rhs.number_text_value();
                 default:
                     return false;
                 }
@@ -1049,16 +1318,24 @@ public:
                     return double_data_cast()->value() == static_cast<double>(rhs.uinteger_data_cast()->value());
                 case json_type_tag::double_t:
                     return double_data_cast()->value() == rhs.double_data_cast()->value();
+                case json_type_tag::small_number_text_t:
+                case json_type_tag::number_text_t:
+                    return double_data_cast()->value() == rhs.number_text_value();
                 default:
                     return false;
                 }
                 break;
+            case json_type_tag::small_number_text_t:
+            case json_type_tag::number_text_t:
+                return variant(number_text_value()) == rhs;
             case json_type_tag::small_string_t:
+            case json_type_tag::string_t:
+            case json_type_tag::string_view_t:
                 switch (rhs.type_id())
                 {
                 case json_type_tag::small_string_t:
-                    return as_string_view() == rhs.as_string_view();
                 case json_type_tag::string_t:
+                case json_type_tag::string_view_t:
                     return as_string_view() == rhs.as_string_view();
                 default:
                     return false;
@@ -1075,17 +1352,6 @@ public:
                     return false;
                 }
                 break;
-            case json_type_tag::string_t:
-                switch (rhs.type_id())
-                {
-                case json_type_tag::small_string_t:
-                    return as_string_view() == rhs.as_string_view();
-                case json_type_tag::string_t:
-                    return as_string_view() == rhs.as_string_view();
-                default:
-                    return false;
-                }
-                break;
             case json_type_tag::array_t:
                 switch (rhs.type_id())
                 {
@@ -1144,6 +1410,7 @@ public:
                     switch (other.type_id())
                     {
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             string_data temp(std::move(*other.string_data_cast()));
                             new(reinterpret_cast<void*>(&(other.data_)))null_data();
@@ -1182,6 +1449,7 @@ public:
                     switch (other.type_id())
                     {
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             string_data temp(std::move(*other.string_data_cast()));
                             new(reinterpret_cast<void*>(&(other.data_)))empty_object_data();
@@ -1220,6 +1488,7 @@ public:
                     switch (other.type_id())
                     {
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             string_data temp(std::move(*other.string_data_cast()));
                             new(reinterpret_cast<void*>(&(other.data_)))bool_data(*bool_data_cast());
@@ -1258,6 +1527,7 @@ public:
                     switch (other.type_id())
                     {
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             string_data temp(std::move(*other.string_data_cast()));
                             new(reinterpret_cast<void*>(&(other.data_)))integer_data(*integer_data_cast());
@@ -1296,6 +1566,7 @@ public:
                     switch (other.type_id())
                     {
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             string_data temp(std::move(*other.string_data_cast()));
                             new(reinterpret_cast<void*>(&(other.data_)))uinteger_data(*uinteger_data_cast());
@@ -1334,6 +1605,7 @@ public:
                     switch (other.type_id())
                     {
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             string_data temp(std::move(*other.string_data_cast()));
                             new(reinterpret_cast<void*>(&(other.data_)))double_data(*double_data_cast());
@@ -1368,10 +1640,12 @@ public:
                 }
                 break;
             case json_type_tag::small_string_t:
+            case json_type_tag::small_number_text_t:
                 {
                     switch (other.type_id())
                     {
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             string_data temp(std::move(*other.string_data_cast()));
                             new(reinterpret_cast<void*>(&(other.data_)))small_string_data(*small_string_data_cast());
@@ -1405,7 +1679,47 @@ public:
                     }
                 }
                 break;
+            case json_type_tag::string_view_t:
+                {
+                    switch (other.type_id())
+                    {
+                    case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
+                        {
+                            string_data temp(std::move(*other.string_data_cast()));
+                            new(reinterpret_cast<void*>(&(other.data_)))string_view_data(*string_view_data_cast());
+                            new(reinterpret_cast<void*>(&data_))string_data(std::move(temp));
+                        }
+                        break;
+                    case json_type_tag::byte_string_t:
+                        {
+                            byte_string_data temp(std::move(*other.byte_string_data_cast()));
+                            new(reinterpret_cast<void*>(&(other.data_)))string_view_data(*string_view_data_cast());
+                            new(reinterpret_cast<void*>(&data_))byte_string_data(std::move(temp));
+                        }
+                        break;
+                    case json_type_tag::array_t:
+                        {
+                            array_data temp(std::move(*other.array_data_cast()));
+                            new(reinterpret_cast<void*>(&(other.data_)))string_view_data(*string_view_data_cast());
+                            new(reinterpret_cast<void*>(&data_))array_data(std::move(temp));
+                        }
+                        break;
+                    case json_type_tag::object_t:
+                        {
+                            object_data temp(std::move(*other.object_data_cast()));
+                            new(reinterpret_cast<void*>(&(other.data_)))string_view_data(*string_view_data_cast());
+                            new(reinterpret_cast<void*>(&data_))object_data(std::move(temp));
+                        }
+                        break;
+                    default:
+                        std::swap(data_,other.data_);
+                        break;
+                    }
+                }
+                break;
             case json_type_tag::string_t:
+            case json_type_tag::number_text_t:
                 {
                     switch (other.type_id())
                     {
@@ -1452,13 +1766,22 @@ public:
                         }
                         break;
                     case json_type_tag::small_string_t:
+                    case json_type_tag::small_number_text_t:
                         {
                             string_data temp(std::move(*string_data_cast()));
                             new(reinterpret_cast<void*>(&data_))small_string_data(*(other.small_string_data_cast()));
                             new(reinterpret_cast<void*>(&other.data_))string_data(std::move(temp));
                         }
                         break;
+                    case json_type_tag::string_view_t:
+                        {
+                            string_data temp(std::move(*string_data_cast()));
+                            new(reinterpret_cast<void*>(&data_))string_view_data(*(other.string_view_data_cast()));
+                            new(reinterpret_cast<void*>(&other.data_))string_data(std::move(temp));
+                        }
+                        break;
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             string_data_cast()->swap(*other.string_data_cast());
                         }
@@ -1537,13 +1860,22 @@ public:
                         }
                         break;
                     case json_type_tag::small_string_t:
+                    case json_type_tag::small_number_text_t:
                         {
                             byte_string_data temp(std::move(*byte_string_data_cast()));
                             new(reinterpret_cast<void*>(&data_))small_string_data(*(other.small_string_data_cast()));
                             new(reinterpret_cast<void*>(&other.data_))byte_string_data(std::move(temp));
                         }
                         break;
+                    case json_type_tag::string_view_t:
+                        {
+                            byte_string_data temp(std::move(*byte_string_data_cast()));
+                            new(reinterpret_cast<void*>(&data_))string_view_data(*(other.string_view_data_cast()));
+                            new(reinterpret_cast<void*>(&other.data_))byte_string_data(std::move(temp));
+                        }
+                        break;
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             byte_string_data temp(std::move(*byte_string_data_cast()));
                             new(reinterpret_cast<void*>(&data_))string_data(*(other.string_data_cast()));
@@ -1622,13 +1954,22 @@ public:
                         }
                         break;
                     case json_type_tag::small_string_t:
+                    case json_type_tag::small_number_text_t:
                         {
                             array_data temp(std::move(*array_data_cast()));
                             new(reinterpret_cast<void*>(&data_))small_string_data(*(other.small_string_data_cast()));
                             new(reinterpret_cast<void*>(&(other.data_)))array_data(std::move(temp));
                         }
                         break;
+                    case json_type_tag::string_view_t:
+                        {
+                            array_data temp(std::move(*array_data_cast()));
+                            new(reinterpret_cast<void*>(&data_))string_view_data(*(other.string_view_data_cast()));
+                            new(reinterpret_cast<void*>(&(other.data_)))array_data(std::move(temp));
+                        }
+                        break;
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             array_data temp(std::move(*array_data_cast()));
                             new(reinterpret_cast<void*>(&data_))string_data(std::move(*other.string_data_cast()));
@@ -1707,13 +2048,22 @@ public:
                         }
                         break;
                     case json_type_tag::small_string_t:
+                    case json_type_tag::small_number_text_t:
                         {
                             object_data temp(std::move(*object_data_cast()));
                             new(reinterpret_cast<void*>(&data_))small_string_data(*(other.small_string_data_cast()));
                             new(reinterpret_cast<void*>(&(other.data_)))object_data(std::move(temp));
                         }
                         break;
+                    case json_type_tag::string_view_t:
+                        {
+                            object_data temp(std::move(*object_data_cast()));
+                            new(reinterpret_cast<void*>(&data_))string_view_data(*(other.string_view_data_cast()));
+                            new(reinterpret_cast<void*>(&(other.data_)))object_data(std::move(temp));
+                        }
+                        break;
                     case json_type_tag::string_t:
+                    case json_type_tag::number_text_t:
                         {
                             object_data temp(std::move(*object_data_cast()));
                             new(reinterpret_cast<void*>(&data_))string_data(std::move(*other.string_data_cast()));
@@ -1775,11 +2125,17 @@ public:
                 new(reinterpret_cast<void*>(&data_))double_data(*(val.double_data_cast()));
                 break;
             case json_type_tag::small_string_t:
+            case json_type_tag::small_number_text_t:
                 new(reinterpret_cast<void*>(&data_))small_string_data(*(val.small_string_data_cast()));
                 break;
             case json_type_tag::string_t:
+            case json_type_tag::number_text_t:
                 new(reinterpret_cast<void*>(&data_))string_data(*(val.string_data_cast()));
                 break;
+            case json_type_tag::string_view_t:
+                // A copy owns its characters
+                Init_string_(val.string_view_data_cast()->data(), val.string_view_data_cast()->length(), Allocator());
+                break;
             case json_type_tag::byte_string_t:
                 new(reinterpret_cast<void*>(&data_))byte_string_data(*(val.byte_string_data_cast()));
                 break;
@@ -1794,6 +2150,18 @@ public:
             }
         }
 
+        void Init_string_(const char_type* s, size_t length, const Allocator& a)
+        {
+            if (length <= small_string_data::max_length)
+            {
+                new(reinterpret_cast<void*>(&data_))small_string_data(s, static_cast<uint8_t>(length));
+            }
+            else
+            {
+                new(reinterpret_cast<void*>(&data_))string_data(s, length, a);
+            }
+        }
+
         void Init_(const variant& val, const Allocator& a)
         {
             switch (val.type_id())
@@ -1805,11 +2173,16 @@ public:
             case json_type_tag::uinteger_t:
             case json_type_tag::double_t:
             case json_type_tag::small_string_t:
+            case json_type_tag::small_number_text_t:
                 Init_(val);
                 break;
             case json_type_tag::string_t:
+            case json_type_tag::number_text_t:
                 new(reinterpret_cast<void*>(&data_))string_data(*(val.string_data_cast()),a);
                 break;
+            case json_type_tag::string_view_t:
+                Init_string_(val.string_view_data_cast()->data(), val.string_view_data_cast()->length(), a);
+                break;
             case json_type_tag::byte_string_t:
                 new(reinterpret_cast<void*>(&data_))byte_string_data(*(val.byte_string_data_cast()),a);
                 break;
@@ -1835,14 +2208,20 @@ public:
             case json_type_tag::uinteger_t:
             case json_type_tag::bool_t:
             case json_type_tag::small_string_t:
+            case json_type_tag::small_number_text_t:
                 Init_(val);
                 break;
             case json_type_tag::string_t:
+            case json_type_tag::number_text_t:
                 {
                     new(reinterpret_cast<void*>(&data_))string_data(std::move(*val.string_data_cast()));
                     new(reinterpret_cast<void*>(&val.data_))null_data();
                 }
                 break;
+            case json_type_tag::string_view_t:
+                // A move keeps referring to the same characters
+                new(reinterpret_cast<void*>(&data_))string_view_data(*val.string_view_data_cast());
+                break;
             case json_type_tag::byte_string_t:
                 {
                     new(reinterpret_cast<void*>(&data_))byte_string_data(std::move(*val.byte_string_data_cast()));
@@ -1883,9 +2262,14 @@ public:
             case json_type_tag::uinteger_t:
             case json_type_tag::bool_t:
             case json_type_tag::small_string_t:
+            case json_type_tag::small_number_text_t:
                 Init_(std::forward<variant>(val));
                 break;
+            case json_type_tag::string_view_t:
+                Init_rv_(std::forward<variant>(val));
+                break;
             case json_type_tag::string_t:
+            case json_type_tag::number_text_t:
                 {
                     if (a == val.string_data_cast()->get_allocator())
                     {
@@ -2136,7 +2520,7 @@ public:
         }
 
         template <class SAllocator>
-        string_type as_string(const SAllocator& allocator) const 
+        std::basic_string<char_type,char_traits_type,SAllocator> as_string(const SAllocator& allocator) const 
         {
             return evaluate().as_string(allocator);
         }
@@ -2147,8 +2531,8 @@ public:
         }
 
         template <class SAllocator>
-        string_type as_string(const basic_serialization_options<char_type>& options,
-                              const SAllocator& allocator) const
+        std::basic_string<char_type,char_traits_type,SAllocator> as_string(const basic_serialization_options<char_type>& options,
+                                                                          const SAllocator& allocator) const
         {
             return evaluate().as_string(options,allocator);
         }
@@ -2175,6 +2559,11 @@ public:
             return evaluate().as_double();
         }
 
+        string_view_type as_number_text() const
+        {
+            return evaluate().as_number_text();
+        }
+
         int64_t as_integer() const
         {
             return evaluate().as_integer();
@@ -2734,15 +3123,29 @@ public:
 
     static basic_json parse(const string_view_type& s, parse_error_handler& err_handler)
     {
-        json_decoder<basic_json> decoder;
-        basic_json_parser<char_type> parser(decoder,err_handler);
-
         auto result = unicons::skip_bom(s.begin(), s.end());
         if (result.ec != unicons::encoding_errc())
         {
             throw parse_error(result.ec,1,1);
         }
         size_t offset = result.it - s.begin();
+
+        // The whole text is in memory, so try the structural index parser first. It accepts
+        // only strict JSON, anything it rejects is parsed again below, and the incremental
+        // parser reports the error or recovers as err_handler directs.
+        {
+            json_decoder<basic_json> decoder;
+            basic_json_index_parser<char_type> parser(decoder);
+            std::error_code ec;
+            parser.parse(s.data()+offset,s.size()-offset,ec);
+            if (!ec && decoder.is_valid())
+            {
+                return decoder.get_result();
+            }
+        }
+
+        json_decoder<basic_json> decoder;
+        basic_json_parser<char_type> parser(decoder,err_handler);
         parser.set_source(s.data()+offset,s.size()-offset);
         parser.parse_some();
         parser.end_parse();
@@ -2754,6 +3157,31 @@ public:
         return decoder.get_result();
     }
 
+    // parse_insitu
+    // Parses a mutable buffer in place with the structural index parser. Escapes are
+    // decoded into the buffer and each string is null terminated there, string values
+    // refer to the buffer instead of copying it, so the buffer must outlive the result.
+    // Strict JSON only. The buffer is modified even if parsing fails.
+    static basic_json parse_insitu(char_type* s, size_t length)
+    {
+        auto result = unicons::skip_bom(s, s + length);
+        if (result.ec != unicons::encoding_errc())
+        {
+            throw parse_error(result.ec,1,1);
+        }
+        size_t offset = result.it - s;
+
+        json_decoder<basic_json> decoder;
+        decoder.reference_strings(true);
+        basic_json_index_parser<char_type> parser(decoder);
+        parser.parse_insitu(s+offset,length-offset);
+        if (!decoder.is_valid())
+        {
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Failed to parse json string"));
+        }
+        return decoder.get_result();
+    }
+
     static basic_json make_array()
     {
         return basic_json(variant(array()));
@@ -2811,6 +3239,30 @@ public:
         return val;
     }
 
+    // make_string_reference
+    // Makes a string value that refers to [s,s+length) instead of copying it. The
+    // characters must outlive the value, copies of the value own their characters.
+    static basic_json make_string_reference(const char_type* s, size_t length)
+    {
+        if (length > variant::string_view_data::max_length)
+        {
+            return basic_json(s, length);
+        }
+        return basic_json(variant(typename variant::string_view_data(s, length)));
+    }
+
+    // make_number_text
+    // Makes a number that keeps [s,s+length), a valid JSON number token, as its text, and
+    // converts it each time it is accessed. It is a double, and serializes as the text.
+    static basic_json make_number_text(const char_type* s, size_t length, const Allocator& allocator = Allocator())
+    {
+        if (length <= variant::small_string_data::max_length)
+        {
+            return basic_json(variant(typename variant::small_string_data(s, static_cast<uint8_t>(length), json_type_tag::small_number_text_t)));
+        }
+        return basic_json(variant(typename variant::string_data(s, length, allocator, json_type_tag::number_text_t)));
+    }
+
     static const basic_json& null()
     {
         static basic_json a_null = basic_json(variant(null_type()));
@@ -3073,6 +3525,7 @@ public:
         {
         case json_type_tag::small_string_t:
         case json_type_tag::string_t:
+        case json_type_tag::string_view_t:
             handler.string_value(as_string_view());
             break;
         case json_type_tag::byte_string_t:
@@ -3081,6 +3534,10 @@ public:
         case json_type_tag::double_t:
             handler.double_value(var_.double_data_cast()->value(), number_format(var_.double_data_cast()->precision(), var_.double_data_cast()->decimal_places()));
             break;
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            handler.number_value(var_.as_number_text());
+            break;
         case json_type_tag::integer_t:
             handler.integer_value(var_.integer_data_cast()->value());
             break;
@@ -3288,7 +3745,7 @@ public:
 
     bool is_string() const JSONCONS_NOEXCEPT
     {
-        return (var_.type_id() == json_type_tag::string_t) || (var_.type_id() == json_type_tag::small_string_t);
+        return (var_.type_id() == json_type_tag::string_t) || (var_.type_id() == json_type_tag::small_string_t) || (var_.type_id() == json_type_tag::string_view_t);
     }
 
     bool is_byte_string() const JSONCONS_NOEXCEPT
@@ -3323,12 +3780,12 @@ public:
 
     bool is_double() const JSONCONS_NOEXCEPT
     {
-        return var_.type_id() == json_type_tag::double_t;
+        return var_.type_id() == json_type_tag::double_t || var_.type_id() == json_type_tag::small_number_text_t || var_.type_id() == json_type_tag::number_text_t;
     }
 
     bool is_number() const JSONCONS_NOEXCEPT
     {
-        return var_.type_id() == json_type_tag::integer_t || var_.type_id() == json_type_tag::uinteger_t || var_.type_id() == json_type_tag::double_t;
+        return var_.type_id() == json_type_tag::integer_t || var_.type_id() == json_type_tag::uinteger_t || is_double();
     }
 
     bool empty() const JSONCONS_NOEXCEPT
@@ -3339,6 +3796,8 @@ public:
             return var_.small_string_data_cast()->length() == 0;
         case json_type_tag::string_t:
             return var_.string_data_cast()->length() == 0;
+        case json_type_tag::string_view_t:
+            return var_.string_view_data_cast()->length() == 0;
         case json_type_tag::array_t:
             return array_value().size() == 0;
         case json_type_tag::empty_object_t:
@@ -3444,6 +3903,7 @@ public:
         {
         case json_type_tag::small_string_t:
         case json_type_tag::string_t:
+        case json_type_tag::string_view_t:
             try
             {
                 basic_json j = basic_json::parse(as_string_view().data(),as_string_view().length());
@@ -3458,6 +3918,9 @@ public:
             return var_.bool_data_cast()->value();
         case json_type_tag::double_t:
             return var_.double_data_cast()->value() != 0.0;
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return var_.number_text_value() != 0.0;
         case json_type_tag::integer_t:
             return var_.integer_data_cast()->value() != 0;
         case json_type_tag::uinteger_t:
@@ -3473,6 +3936,7 @@ public:
         {
         case json_type_tag::small_string_t:
         case json_type_tag::string_t:
+        case json_type_tag::string_view_t:
             try
             {
                 basic_json j = basic_json::parse(as_string_view().data(),as_string_view().length());
@@ -3485,6 +3949,9 @@ public:
             break;
         case json_type_tag::double_t:
             return static_cast<int64_t>(var_.double_data_cast()->value());
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return static_cast<int64_t>(var_.number_text_value());
         case json_type_tag::integer_t:
             return static_cast<int64_t>(var_.integer_data_cast()->value());
         case json_type_tag::uinteger_t:
@@ -3502,6 +3969,7 @@ public:
         {
         case json_type_tag::small_string_t:
         case json_type_tag::string_t:
+        case json_type_tag::string_view_t:
             try
             {
                 basic_json j = basic_json::parse(as_string_view().data(),as_string_view().length());
@@ -3514,6 +3982,9 @@ public:
             break;
         case json_type_tag::double_t:
             return static_cast<uint64_t>(var_.double_data_cast()->value());
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return static_cast<uint64_t>(var_.number_text_value());
         case json_type_tag::integer_t:
             return static_cast<uint64_t>(var_.integer_data_cast()->value());
         case json_type_tag::uinteger_t:
@@ -3531,6 +4002,9 @@ public:
         {
         case json_type_tag::double_t:
             return var_.double_data_cast()->precision();
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return detail::number_text_format(var_.as_number_text().data(), var_.as_number_text().length()).precision();
         default:
             JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a double"));
         }
@@ -3542,17 +4016,28 @@ public:
         {
         case json_type_tag::double_t:
             return var_.double_data_cast()->decimal_places();
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return detail::number_text_format(var_.as_number_text().data(), var_.as_number_text().length()).decimal_places();
         default:
             JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a double"));
         }
     }
 
+    // as_number_text
+    // The token of a number made by make_number_text or decoded with lazy_numbers
+    string_view_type as_number_text() const
+    {
+        return var_.as_number_text();
+    }
+
     double as_double() const
     {
         switch (var_.type_id())
         {
         case json_type_tag::small_string_t:
         case json_type_tag::string_t:
+        case json_type_tag::string_view_t:
             try
             {
                 basic_json j = basic_json::parse(as_string_view().data(),as_string_view().length());
@@ -3565,6 +4050,9 @@ public:
             break;
         case json_type_tag::double_t:
             return var_.double_data_cast()->value();
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return var_.number_text_value();
         case json_type_tag::integer_t:
             return static_cast<double>(var_.integer_data_cast()->value());
         case json_type_tag::uinteger_t:
@@ -3592,6 +4080,7 @@ public:
         {
         case json_type_tag::small_string_t:
         case json_type_tag::string_t:
+        case json_type_tag::string_view_t:
             return string_type(as_string_view().data(),as_string_view().length());
         default:
             return to_string();
@@ -3599,15 +4088,21 @@ public:
     }
 
     template <class SAllocator>
-    string_type as_string(const SAllocator& allocator) const 
+    std::basic_string<char_type,char_traits_type,SAllocator> as_string(const SAllocator& allocator) const 
     {
+        typedef std::basic_string<char_type,char_traits_type,SAllocator> result_type;
         switch (var_.type_id())
         {
         case json_type_tag::small_string_t:
         case json_type_tag::string_t:
-            return string_type(as_string_view().data(),as_string_view().length(),allocator);
+        case json_type_tag::string_view_t:
+            return result_type(as_string_view().data(),as_string_view().length(),allocator);
         default:
-            return to_string(allocator);
+            {
+                result_type s(allocator);
+                dump(s);
+                return s;
+            }
         }
     }
 
@@ -3617,6 +4112,7 @@ public:
         {
         case json_type_tag::small_string_t:
         case json_type_tag::string_t:
+        case json_type_tag::string_view_t:
             return string_type(as_string_view().data(),as_string_view().length());
         default:
             return to_string(options);
@@ -3624,16 +4120,22 @@ public:
     }
 
     template <class SAllocator>
-    string_type as_string(const basic_serialization_options<char_type>& options,
-                          const SAllocator& allocator) const 
+    std::basic_string<char_type,char_traits_type,SAllocator> as_string(const basic_serialization_options<char_type>& options,
+                                                                      const SAllocator& allocator) const 
     {
+        typedef std::basic_string<char_type,char_traits_type,SAllocator> result_type;
         switch (var_.type_id())
         {
         case json_type_tag::small_string_t:
         case json_type_tag::string_t:
-            return string_type(as_string_view().data(),as_string_view().length(),allocator);
+        case json_type_tag::string_view_t:
+            return result_type(as_string_view().data(),as_string_view().length(),allocator);
         default:
-            return to_string(options,allocator);
+            {
+                result_type s(allocator);
+                dump(s,options);
+                return s;
+            }
         }
     }
 
@@ -3645,6 +4147,8 @@ public:
             return var_.small_string_data_cast()->c_str();
         case json_type_tag::string_t:
             return var_.string_data_cast()->c_str();
+        case json_type_tag::string_view_t:
+            return var_.string_view_data_cast()->c_str();
         default:
             JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a cstring"));
         }
@@ -3658,6 +4162,9 @@ public:
         {
         case json_type_tag::double_t:
             return var_.double_data_cast()->precision();
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return detail::number_text_format(var_.as_number_text().data(), var_.as_number_text().length()).precision();
         default:
             JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a double"));
         }
@@ -4528,6 +5035,9 @@ public:
         {
         case json_type_tag::double_t:
             return static_cast<int>(var_.double_data_cast()->value());
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return static_cast<int>(var_.number_text_value());
         case json_type_tag::integer_t:
             return static_cast<int>(var_.integer_data_cast()->value());
         case json_type_tag::uinteger_t:
@@ -4545,6 +5055,9 @@ public:
         {
         case json_type_tag::double_t:
             return static_cast<unsigned int>(var_.double_data_cast()->value());
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return static_cast<unsigned int>(var_.number_text_value());
         case json_type_tag::integer_t:
             return static_cast<unsigned int>(var_.integer_data_cast()->value());
         case json_type_tag::uinteger_t:
@@ -4562,6 +5075,9 @@ public:
         {
         case json_type_tag::double_t:
             return static_cast<long>(var_.double_data_cast()->value());
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return static_cast<long>(var_.number_text_value());
         case json_type_tag::integer_t:
             return static_cast<long>(var_.integer_data_cast()->value());
         case json_type_tag::uinteger_t:
@@ -4579,6 +5095,9 @@ public:
         {
         case json_type_tag::double_t:
             return static_cast<unsigned long>(var_.double_data_cast()->value());
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
+            return static_cast<unsigned long>(var_.number_text_value());
         case json_type_tag::integer_t:
             return static_cast<unsigned long>(var_.integer_data_cast()->value());
         case json_type_tag::uinteger_t:
@@ -4929,6 +5448,8 @@ typedef basic_json<char,sorted_policy,std::allocator<char>> json;
 typedef basic_json<wchar_t,sorted_policy,std::allocator<wchar_t>> wjson;
 typedef basic_json<char, preserve_order_policy, std::allocator<char>> ojson;
 typedef basic_json<wchar_t, preserve_order_policy, std::allocator<wchar_t>> wojson;
+typedef basic_json<char,copy_on_write_policy<sorted_policy>,std::allocator<char>> shared_json;
+typedef basic_json<char,copy_on_write_policy<preserve_order_policy>,std::allocator<char>> shared_ojson;
 
 #if !defined(JSONCONS_NO_DEPRECATED)
 typedef basic_json<wchar_t, preserve_order_policy, std::allocator<wchar_t>> owjson;
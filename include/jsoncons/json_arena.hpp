@@ -0,0 +1,302 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_ARENA_HPP
+#define JSONCONS_JSON_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <memory>
+#include <istream>
+#include <type_traits>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_index_parser.hpp>
+
+namespace jsoncons {
+
+// arena
+// A monotonic memory resource. Allocation bumps a pointer through a block, deallocation does
+// nothing, and reset() releases everything at once, keeping the most recent block for reuse.
+// Blocks grow geometrically, so a document of n bytes takes O(log n) calls to operator new.
+
+class arena
+{
+    struct block
+    {
+        block* next_;
+        size_t size_;
+    };
+
+    static const size_t header_size = (sizeof(block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    block* head_;
+    char* ptr_;
+    char* end_;
+    size_t initial_block_size_;
+    size_t next_block_size_;
+
+    // Noncopyable and nonmoveable
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+public:
+    static const size_t default_block_size = 4096;
+
+    arena(size_t initial_block_size = default_block_size)
+        : head_(nullptr), ptr_(nullptr), end_(nullptr),
+          initial_block_size_(initial_block_size > 0 ? initial_block_size : default_block_size),
+          next_block_size_(initial_block_size_)
+    {
+    }
+
+    ~arena()
+    {
+        release();
+    }
+
+    void* allocate(size_t n, size_t alignment)
+    {
+        uintptr_t p = (reinterpret_cast<uintptr_t>(ptr_) + (alignment - 1)) & ~static_cast<uintptr_t>(alignment - 1);
+        if (ptr_ == nullptr || n > static_cast<size_t>(reinterpret_cast<uintptr_t>(end_) - p))
+        {
+            add_block(n + alignment);
+            p = (reinterpret_cast<uintptr_t>(ptr_) + (alignment - 1)) & ~static_cast<uintptr_t>(alignment - 1);
+        }
+        ptr_ = reinterpret_cast<char*>(p + n);
+        return reinterpret_cast<void*>(p);
+    }
+
+    // Frees all blocks but the most recent, which is the largest, and starts over in it
+    void reset()
+    {
+        if (head_ != nullptr)
+        {
+            free_blocks(head_->next_);
+            head_->next_ = nullptr;
+            ptr_ = reinterpret_cast<char*>(head_) + header_size;
+            end_ = reinterpret_cast<char*>(head_) + header_size + head_->size_;
+        }
+    }
+
+    // Frees all blocks
+    void release()
+    {
+        free_blocks(head_);
+        head_ = nullptr;
+        ptr_ = end_ = nullptr;
+        next_block_size_ = initial_block_size_;
+    }
+
+    // Total size of the blocks held
+    size_t capacity() const
+    {
+        size_t size = 0;
+        for (block* b = head_; b != nullptr; b = b->next_)
+        {
+            size += b->size_;
+        }
+        return size;
+    }
+private:
+    void add_block(size_t n)
+    {
+        size_t size = next_block_size_;
+        while (size < n)
+        {
+            size *= 2;
+        }
+        void* p = ::operator new(header_size + size);
+        block* b = static_cast<block*>(p);
+        b->next_ = head_;
+        b->size_ = size;
+        head_ = b;
+        ptr_ = static_cast<char*>(p) + header_size;
+        end_ = ptr_ + size;
+        next_block_size_ = size * 2;
+    }
+
+    static void free_blocks(block* b)
+    {
+        while (b != nullptr)
+        {
+            block* next = b->next_;
+            ::operator delete(b);
+            b = next;
+        }
+    }
+};
+
+// arena_allocator
+// A stateful allocator that allocates from an arena. A default constructed arena_allocator
+// has no arena and uses operator new and delete.
+
+template <class T>
+class arena_allocator
+{
+    template <class U> friend class arena_allocator;
+
+    arena* arena_;
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef arena_allocator<U> other;
+    };
+
+    arena_allocator() JSONCONS_NOEXCEPT
+        : arena_(nullptr)
+    {
+    }
+
+    arena_allocator(arena& a) JSONCONS_NOEXCEPT
+        : arena_(std::addressof(a))
+    {
+    }
+
+    arena_allocator(const arena_allocator& other) JSONCONS_NOEXCEPT = default;
+
+    template <class U>
+    arena_allocator(const arena_allocator<U>& other) JSONCONS_NOEXCEPT
+        : arena_(other.arena_)
+    {
+    }
+
+    arena_allocator& operator=(const arena_allocator& other) JSONCONS_NOEXCEPT = default;
+
+    T* allocate(size_type n)
+    {
+        if (arena_ == nullptr)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_type) JSONCONS_NOEXCEPT
+    {
+        if (arena_ == nullptr)
+        {
+            ::operator delete(p);
+        }
+    }
+
+    size_type max_size() const JSONCONS_NOEXCEPT
+    {
+        return size_t(-1) / sizeof(T);
+    }
+
+    arena* get_arena() const JSONCONS_NOEXCEPT
+    {
+        return arena_;
+    }
+
+    template <class U>
+    bool operator==(const arena_allocator<U>& other) const JSONCONS_NOEXCEPT
+    {
+        return arena_ == other.arena_;
+    }
+
+    template <class U>
+    bool operator!=(const arena_allocator<U>& other) const JSONCONS_NOEXCEPT
+    {
+        return arena_ != other.arena_;
+    }
+};
+
+typedef basic_json<char,sorted_policy,arena_allocator<char>> arena_json;
+typedef basic_json<char,preserve_order_policy,arena_allocator<char>> arena_ojson;
+
+namespace detail {
+
+template <class Json>
+Json& construct_in_arena(arena& a, Json&& val)
+{
+    void* p = a.allocate(sizeof(Json), alignof(Json));
+    return *::new(p) Json(std::move(val));
+}
+
+}
+
+// decode_in_arena
+// Parses JSON text into a Json value that is itself placed in the arena and never destroyed.
+// Every string, array and object of the document is allocated from the arena, so freeing the
+// document is a reset() or release() of the arena, with no destructors run. The returned
+// reference is valid until then.
+
+template <class Json>
+Json& decode_in_arena(arena& a, const typename Json::string_view_type& s)
+{
+    typedef typename Json::char_type char_type;
+    typedef typename Json::allocator_type allocator_type;
+    static_assert(std::is_same<allocator_type,arena_allocator<typename allocator_type::value_type>>::value,
+                  "decode_in_arena requires a Json type with an arena_allocator");
+
+    auto result = unicons::skip_bom(s.begin(), s.end());
+    if (result.ec != unicons::encoding_errc())
+    {
+        throw parse_error(result.ec,1,1);
+    }
+    size_t offset = result.it - s.begin();
+
+    // As in basic_json::parse, strict JSON goes through the structural index parser. Whatever
+    // a rejected attempt allocated stays in the arena until it is reset.
+    {
+        json_decoder<Json> decoder{allocator_type(a)};
+        basic_json_index_parser<char_type> parser(decoder);
+        std::error_code ec;
+        parser.parse(s.data()+offset,s.size()-offset,ec);
+        if (!ec && decoder.is_valid())
+        {
+            return detail::construct_in_arena(a, decoder.get_result());
+        }
+    }
+
+    json_decoder<Json> decoder{allocator_type(a)};
+    basic_json_parser<char_type> parser(decoder);
+    parser.set_source(s.data()+offset,s.size()-offset);
+    parser.parse_some();
+    parser.end_parse();
+    parser.check_done();
+    if (!decoder.is_valid())
+    {
+        JSONCONS_THROW(json_exception_impl<std::runtime_error>("Failed to parse json string"));
+    }
+    return detail::construct_in_arena(a, decoder.get_result());
+}
+
+template <class Json>
+Json& decode_in_arena(arena& a, std::basic_istream<typename Json::char_type>& is)
+{
+    typedef typename Json::allocator_type allocator_type;
+    static_assert(std::is_same<allocator_type,arena_allocator<typename allocator_type::value_type>>::value,
+                  "decode_in_arena requires a Json type with an arena_allocator");
+
+    json_decoder<Json> decoder{allocator_type(a)};
+    basic_json_reader<typename Json::char_type> reader(is, decoder);
+    reader.read_next();
+    reader.check_done();
+    if (!decoder.is_valid())
+    {
+        JSONCONS_THROW(json_exception_impl<std::runtime_error>("Failed to parse json stream"));
+    }
+    return detail::construct_in_arena(a, decoder.get_result());
+}
+
+}
+
+#endif
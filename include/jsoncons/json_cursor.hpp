@@ -0,0 +1,558 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_CURSOR_HPP
+#define JSONCONS_JSON_CURSOR_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <istream>
+#include <stdexcept>
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_input_handler.hpp>
+#include <jsoncons/parse_error_handler.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/source.hpp>
+
+namespace jsoncons {
+
+enum class json_event_type
+{
+    begin_object,
+    end_object,
+    begin_array,
+    end_array,
+    name,
+    string_value,
+    integer_value,
+    uinteger_value,
+    double_value,
+    bool_value,
+    null_value
+};
+
+template<class CharT>
+class basic_json_event
+{
+public:
+    typedef CharT char_type;
+    typedef typename basic_json_input_handler<CharT>::string_view_type string_view_type;
+private:
+    json_event_type event_type_;
+    string_view_type s_;
+    union
+    {
+        int64_t integer_val_;
+        uint64_t uinteger_val_;
+        double double_val_;
+        bool bool_val_;
+    } value_;
+    number_format fmt_;
+public:
+    basic_json_event(json_event_type event_type)
+        : event_type_(event_type)
+    {
+        value_.integer_val_ = 0;
+    }
+
+    basic_json_event(json_event_type event_type, const string_view_type& s)
+        : event_type_(event_type), s_(s)
+    {
+        value_.integer_val_ = 0;
+    }
+
+    basic_json_event(int64_t value)
+        : event_type_(json_event_type::integer_value)
+    {
+        value_.integer_val_ = value;
+    }
+
+    basic_json_event(uint64_t value)
+        : event_type_(json_event_type::uinteger_value)
+    {
+        value_.uinteger_val_ = value;
+    }
+
+    basic_json_event(double value, const number_format& fmt)
+        : event_type_(json_event_type::double_value), fmt_(fmt)
+    {
+        value_.double_val_ = value;
+    }
+
+    basic_json_event(bool value)
+        : event_type_(json_event_type::bool_value)
+    {
+        value_.bool_val_ = value;
+    }
+
+    json_event_type event_type() const
+    {
+        return event_type_;
+    }
+
+    // Valid for name and string_value events, until the next call to next()
+    string_view_type as_string_view() const
+    {
+        return s_;
+    }
+
+    int64_t as_integer() const
+    {
+        switch (event_type_)
+        {
+        case json_event_type::integer_value:
+            return value_.integer_val_;
+        case json_event_type::uinteger_value:
+            return static_cast<int64_t>(value_.uinteger_val_);
+        case json_event_type::double_value:
+            return static_cast<int64_t>(value_.double_val_);
+        case json_event_type::bool_value:
+            return value_.bool_val_ ? 1 : 0;
+        default:
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not an integer"));
+        }
+    }
+
+    uint64_t as_uinteger() const
+    {
+        switch (event_type_)
+        {
+        case json_event_type::integer_value:
+            return static_cast<uint64_t>(value_.integer_val_);
+        case json_event_type::uinteger_value:
+            return value_.uinteger_val_;
+        case json_event_type::double_value:
+            return static_cast<uint64_t>(value_.double_val_);
+        case json_event_type::bool_value:
+            return value_.bool_val_ ? 1 : 0;
+        default:
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not an unsigned integer"));
+        }
+    }
+
+    double as_double() const
+    {
+        switch (event_type_)
+        {
+        case json_event_type::integer_value:
+            return static_cast<double>(value_.integer_val_);
+        case json_event_type::uinteger_value:
+            return static_cast<double>(value_.uinteger_val_);
+        case json_event_type::double_value:
+            return value_.double_val_;
+        default:
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a double"));
+        }
+    }
+
+    bool as_bool() const
+    {
+        switch (event_type_)
+        {
+        case json_event_type::bool_value:
+            return value_.bool_val_;
+        default:
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a bool"));
+        }
+    }
+
+    const number_format& format() const
+    {
+        return fmt_;
+    }
+
+    void send_to(basic_json_input_handler<CharT>& handler, const parsing_context& context) const
+    {
+        switch (event_type_)
+        {
+        case json_event_type::begin_object:
+            handler.begin_object(context);
+            break;
+        case json_event_type::end_object:
+            handler.end_object(context);
+            break;
+        case json_event_type::begin_array:
+            handler.begin_array(context);
+            break;
+        case json_event_type::end_array:
+            handler.end_array(context);
+            break;
+        case json_event_type::name:
+            handler.name(s_, context);
+            break;
+        case json_event_type::string_value:
+            handler.string_value(s_, context);
+            break;
+        case json_event_type::integer_value:
+            handler.integer_value(value_.integer_val_, context);
+            break;
+        case json_event_type::uinteger_value:
+            handler.uinteger_value(value_.uinteger_val_, context);
+            break;
+        case json_event_type::double_value:
+            handler.double_value(value_.double_val_, fmt_, context);
+            break;
+        case json_event_type::bool_value:
+            handler.bool_value(value_.bool_val_, context);
+            break;
+        case json_event_type::null_value:
+            handler.null_value(context);
+            break;
+        }
+    }
+};
+
+// basic_json_cursor
+// Pulls events one at a time from basic_json_parser. The cursor is itself the parser's
+// input handler: it stages the events of one step of the parser and stops it, so at most
+// a few events are held at any time and string events are views into the source or
+// the parser's string buffer, not copies.
+
+template<class CharT,class Allocator=std::allocator<char>,class Src=stream_source<CharT>>
+class basic_json_cursor : private basic_json_input_handler<CharT>
+{
+    static const size_t default_max_buffer_length = 16384;
+
+    typedef CharT char_type;
+    typedef Allocator allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<CharT> char_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<basic_json_event<CharT>> event_allocator_type;
+public:
+    typedef typename basic_json_input_handler<CharT>::string_view_type string_view_type;
+private:
+    basic_json_parser<CharT,Allocator> parser_;
+    Src source_;
+    std::vector<CharT,char_allocator_type> buffer_;
+    size_t buffer_length_;
+    std::vector<basic_json_event<CharT>,event_allocator_type> events_;
+    size_t index_;
+    bool eof_;
+    bool begin_;
+
+    // Noncopyable and nonmoveable
+    basic_json_cursor(const basic_json_cursor&) = delete;
+    basic_json_cursor& operator=(const basic_json_cursor&) = delete;
+
+public:
+
+    template <class Source>
+    basic_json_cursor(Source&& source)
+        : parser_(*this),
+          source_(std::forward<Source>(source)),
+          buffer_length_(default_max_buffer_length),
+          index_(0),
+          eof_(false),
+          begin_(true)
+    {
+        std::error_code ec;
+        start(ec);
+        if (ec)
+        {
+            throw parse_error(ec,parser_.line_number(),parser_.column_number());
+        }
+    }
+
+    template <class Source>
+    basic_json_cursor(Source&& source,
+                      parse_error_handler& err_handler)
+        : parser_(*this,err_handler),
+          source_(std::forward<Source>(source)),
+          buffer_length_(default_max_buffer_length),
+          index_(0),
+          eof_(false),
+          begin_(true)
+    {
+        std::error_code ec;
+        start(ec);
+        if (ec)
+        {
+            throw parse_error(ec,parser_.line_number(),parser_.column_number());
+        }
+    }
+
+    template <class Source>
+    basic_json_cursor(Source&& source,
+                      std::error_code& ec)
+        : parser_(*this),
+          source_(std::forward<Source>(source)),
+          buffer_length_(default_max_buffer_length),
+          index_(0),
+          eof_(false),
+          begin_(true)
+    {
+        start(ec);
+    }
+
+    bool done() const
+    {
+        return index_ >= events_.size();
+    }
+
+    const basic_json_event<CharT>& current() const
+    {
+        return events_[index_];
+    }
+
+    void next()
+    {
+        std::error_code ec;
+        next(ec);
+        if (ec)
+        {
+            throw parse_error(ec,parser_.line_number(),parser_.column_number());
+        }
+    }
+
+    void next(std::error_code& ec)
+    {
+        if (++index_ < events_.size())
+        {
+            return;
+        }
+        events_.clear();
+        index_ = 0;
+        read_next(ec);
+    }
+
+    // Sends the current event to handler, framed by begin_json and end_json, and if it
+    // begins an object or array, every event up to and including the matching end.
+    // The cursor is left on the last event sent.
+    void read_to(basic_json_input_handler<CharT>& handler)
+    {
+        std::error_code ec;
+        read_to(handler, ec);
+        if (ec)
+        {
+            throw parse_error(ec,parser_.line_number(),parser_.column_number());
+        }
+    }
+
+    void read_to(basic_json_input_handler<CharT>& handler, std::error_code& ec)
+    {
+        handler.begin_json();
+        size_t level = 0;
+        for (;;)
+        {
+            if (done())
+            {
+                ec = json_parser_errc::unexpected_eof;
+                return;
+            }
+            const basic_json_event<CharT>& event = current();
+            event.send_to(handler, parser_.parsing_context());
+            switch (event.event_type())
+            {
+            case json_event_type::begin_object:
+            case json_event_type::begin_array:
+                ++level;
+                break;
+            case json_event_type::end_object:
+            case json_event_type::end_array:
+                --level;
+                break;
+            default:
+                break;
+            }
+            if (level == 0)
+            {
+                break;
+            }
+            next(ec);
+            if (ec) return;
+        }
+        handler.end_json();
+    }
+
+    size_t line_number() const
+    {
+        return parser_.line_number();
+    }
+
+    size_t column_number() const
+    {
+        return parser_.column_number();
+    }
+
+    size_t buffer_length() const
+    {
+        return buffer_length_;
+    }
+
+    void buffer_length(size_t length)
+    {
+        buffer_length_ = length;
+    }
+
+    size_t max_nesting_depth() const
+    {
+        return parser_.max_nesting_depth();
+    }
+
+    void max_nesting_depth(size_t depth)
+    {
+        parser_.max_nesting_depth(depth);
+    }
+
+private:
+
+    void start(std::error_code& ec)
+    {
+        parser_.reset();
+        read_next(ec);
+    }
+
+    void read_buffer(std::error_code& ec)
+    {
+        if (buffer_.size() != buffer_length_)
+        {
+            buffer_.resize(buffer_length_);
+        }
+        const CharT* data = buffer_.data();
+        size_t length = source_.read_buffer(buffer_.data(), buffer_length_, data);
+        if (length == 0)
+        {
+            eof_ = true;
+        }
+        else if (begin_)
+        {
+            auto result = unicons::skip_bom(data, data+length);
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            size_t offset = result.it - data;
+            parser_.set_source(data+offset,length-offset);
+            begin_ = false;
+        }
+        else
+        {
+            parser_.set_source(data,length);
+        }
+    }
+
+    void read_next(std::error_code& ec)
+    {
+        while (events_.empty() && !parser_.done())
+        {
+            if (parser_.source_exhausted())
+            {
+                if (!eof_ && !source_.eof())
+                {
+                    if (source_.is_error())
+                    {
+                        ec = json_parser_errc::source_error;
+                        return;
+                    }
+                    read_buffer(ec);
+                    if (ec) return;
+                }
+                else
+                {
+                    parser_.end_parse(ec);
+                    return;
+                }
+            }
+            else
+            {
+                parser_.restart();
+                parser_.parse_some(ec);
+                if (ec) return;
+            }
+        }
+    }
+
+    void do_begin_json() override
+    {
+    }
+
+    void do_end_json() override
+    {
+    }
+
+    void do_begin_object(const parsing_context&) override
+    {
+        events_.emplace_back(json_event_type::begin_object);
+        parser_.stop();
+    }
+
+    void do_end_object(const parsing_context&) override
+    {
+        events_.emplace_back(json_event_type::end_object);
+        parser_.stop();
+    }
+
+    void do_begin_array(const parsing_context&) override
+    {
+        events_.emplace_back(json_event_type::begin_array);
+        parser_.stop();
+    }
+
+    void do_end_array(const parsing_context&) override
+    {
+        events_.emplace_back(json_event_type::end_array);
+        parser_.stop();
+    }
+
+    void do_name(const string_view_type& name, const parsing_context&) override
+    {
+        events_.emplace_back(json_event_type::name, name);
+        parser_.stop();
+    }
+
+    void do_null_value(const parsing_context&) override
+    {
+        events_.emplace_back(json_event_type::null_value);
+        parser_.stop();
+    }
+
+    void do_string_value(const string_view_type& value, const parsing_context&) override
+    {
+        events_.emplace_back(json_event_type::string_value, value);
+        parser_.stop();
+    }
+
+    void do_byte_string_value(const uint8_t*, size_t, const parsing_context&) override
+    {
+    }
+
+    void do_double_value(double value, const number_format& fmt, const parsing_context&) override
+    {
+        events_.emplace_back(value, fmt);
+        parser_.stop();
+    }
+
+    void do_integer_value(int64_t value, const parsing_context&) override
+    {
+        events_.emplace_back(value);
+        parser_.stop();
+    }
+
+    void do_uinteger_value(uint64_t value, const parsing_context&) override
+    {
+        events_.emplace_back(value);
+        parser_.stop();
+    }
+
+    void do_bool_value(bool value, const parsing_context&) override
+    {
+        events_.emplace_back(value);
+        parser_.stop();
+    }
+};
+
+typedef basic_json_event<char> json_event;
+typedef basic_json_event<wchar_t> wjson_event;
+
+typedef basic_json_cursor<char> json_cursor;
+typedef basic_json_cursor<wchar_t> wjson_cursor;
+
+}
+
+#endif
+
@@ -13,6 +13,7 @@
 #include <istream>
 #include <cstdlib>
 #include <memory>
+#include <iterator>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_input_handler.hpp>
 
@@ -40,53 +41,54 @@ public:
     json_array_allocator array_allocator_;
 
     Json result_;
+    key_storage_type name_;
 
-    struct stack_item
-    {
-        stack_item(key_storage_type&& name)
-            : name_(std::forward<key_storage_type>(name))
-        {
-        }
-        stack_item(Json&& value)
-            : value_(std::forward<Json>(value))
-        {
-        }
-
-        stack_item() = default;
-        stack_item(const stack_item&) = default;
-        stack_item(stack_item&&) = default;
-        stack_item& operator=(const stack_item&) = default;
-        stack_item& operator=(stack_item&&) = default;
-
-        key_storage_type name_;
-        Json value_;
-    };
-
-    struct structure_offset
+    // Members of the open objects and elements of the open arrays are constructed in place
+    // at the end of these stacks, a value that is itself an array or object starts out as
+    // null. When an array or object ends, its members or elements are moved once into a
+    // container of exactly the right size, which then replaces the null.
+    struct structure_info
     {
         size_t offset_;
         bool is_object_;
     };
 
     typedef Allocator allocator_type;
-    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<stack_item> stack_item_allocator_type;
-    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<structure_offset> size_t_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_value_pair_type> member_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<Json> element_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<structure_info> structure_info_allocator_type;
 
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_storage_type> key_allocator_type;
 
-    std::vector<stack_item,stack_item_allocator_type> stack_;
-    std::vector<structure_offset,size_t_allocator_type> stack_offsets_;
+    std::vector<key_value_pair_type,member_allocator_type> member_stack_;
+    std::vector<Json,element_allocator_type> element_stack_;
+    std::vector<structure_info,structure_info_allocator_type> structure_stack_;
     bool is_valid_;
+    bool reference_strings_;
+    bool intern_keys_;
+    bool lazy_numbers_;
+
+    // Interned member names, an open addressing table in which an empty name marks an empty slot.
+    // Once it holds max_interned_keys names, further names are not interned.
+    static const size_t max_interned_keys = 4096;
+    std::vector<key_storage_type,key_allocator_type> interned_keys_;
+    size_t interned_count_;
 
 public:
     json_decoder(const json_allocator_type& jallocator = json_allocator_type())
         : string_allocator_(jallocator),
           object_allocator_(jallocator),
           array_allocator_(jallocator),
-          is_valid_(false) 
-
+          name_(string_allocator_),
+          is_valid_(false),
+          reference_strings_(false),
+          intern_keys_(false),
+          lazy_numbers_(false),
+          interned_count_(0)
     {
-        stack_offsets_.reserve(100);
-        stack_.reserve(1000);
+        member_stack_.reserve(1000);
+        element_stack_.reserve(1000);
+        structure_stack_.reserve(100);
     }
 
     bool is_valid() const
@@ -94,6 +96,50 @@ public:
         return is_valid_;
     }
 
+    bool reference_strings() const
+    {
+        return reference_strings_;
+    }
+
+    // When set, string values refer to the characters passed to do_string_value instead
+    // of copying them, the caller guarantees that those outlive the result
+    void reference_strings(bool value)
+    {
+        reference_strings_ = value;
+    }
+
+    bool intern_keys() const
+    {
+        return intern_keys_;
+    }
+
+    // When set, member names are looked up in a table kept by the decoder for as long as it
+    // lives, and repeated names are copies of the first. With a key_storage_type that shares
+    // its characters among copies, such as the one of shared_keys_policy, each distinct name
+    // is then stored once. Setting it to false empties the table.
+    void intern_keys(bool value)
+    {
+        intern_keys_ = value;
+        if (!value)
+        {
+            interned_keys_.clear();
+            interned_count_ = 0;
+        }
+    }
+
+    bool lazy_numbers() const
+    {
+        return lazy_numbers_;
+    }
+
+    // When set, numbers with a fraction or an exponent, or too large for a 64 bit integer, are
+    // kept as their text and converted each time they are accessed, parsers do not convert them
+    // and serializers write the text as it is
+    void lazy_numbers(bool value)
+    {
+        lazy_numbers_ = value;
+    }
+
     Json get_result()
     {
         is_valid_ = false;
@@ -109,199 +155,210 @@ public:
 
 private:
 
-    void push_object()
+    template <class T>
+    void add_value(T&& value)
     {
-        if (stack_offsets_.back().is_object_)
+        if (structure_stack_.empty())
+        {
+            result_ = Json(std::forward<T>(value));
+        }
+        else if (structure_stack_.back().is_object_)
         {
-            stack_.back().value_ = Json(object(object_allocator_));
+            member_stack_.emplace_back(std::move(name_), std::forward<T>(value));
         }
         else
         {
-            stack_.push_back(Json(object(object_allocator_)));
+            element_stack_.emplace_back(std::forward<T>(value));
         }
-        stack_offsets_.push_back({stack_.size()-1,true});
     }
 
-    void pop_object()
+    // Replaces the null that stands for the array or object that has just ended
+    void end_structure(Json&& value)
     {
-        stack_.erase(stack_.begin()+stack_offsets_.back().offset_+1, stack_.end());
-        stack_offsets_.pop_back();
-    }
-
-    void push_array()
-    {
-        if (stack_offsets_.back().is_object_)
+        if (structure_stack_.empty())
+        {
+            result_ = std::move(value);
+        }
+        else if (structure_stack_.back().is_object_)
         {
-            stack_.back().value_ = Json(array(array_allocator_));
+            member_stack_.back().value() = std::move(value);
         }
         else
         {
-            stack_.push_back(Json(array(array_allocator_)));
+            element_stack_.back() = std::move(value);
         }
-        stack_offsets_.push_back({stack_.size()-1,false});
-    }
-
-    void pop_array()
-    {
-        stack_.erase(stack_.begin()+stack_offsets_.back().offset_+1, stack_.end());
-        stack_offsets_.pop_back();
     }
 
     void do_begin_json() override
     {
-        stack_offsets_.clear();
-        stack_.clear();
-        stack_offsets_.push_back({0,false});
+        member_stack_.clear();
+        element_stack_.clear();
+        structure_stack_.clear();
         is_valid_ = false;
     }
 
     void do_end_json() override
     {
-        if (stack_.size() == 1)
+        if (structure_stack_.empty())
         {
-            result_.swap(stack_.front().value_);
-            stack_.pop_back();
             is_valid_ = true;
         }
     }
 
     void do_begin_object(const parsing_context&) override
     {
-        push_object();
+        add_value(Json::null());
+        structure_stack_.push_back({member_stack_.size(),true});
     }
 
     void do_end_object(const parsing_context&) override
     {
-        end_structure();
-        pop_object();
+        JSONCONS_ASSERT(structure_stack_.size() > 0);
+        auto first = member_stack_.begin() + structure_stack_.back().offset_;
+        structure_stack_.pop_back();
+
+        object members(object_allocator_);
+        members.insert_unchecked(std::make_move_iterator(first),
+                                 std::make_move_iterator(member_stack_.end()));
+        members.normalize();
+        member_stack_.erase(first, member_stack_.end());
+        end_structure(Json(std::move(members)));
     }
 
     void do_begin_array(const parsing_context&) override
     {
-        push_array();
+        add_value(Json::null());
+        structure_stack_.push_back({element_stack_.size(),false});
     }
 
     void do_end_array(const parsing_context&) override
     {
-        end_structure();
-        pop_array();
+        JSONCONS_ASSERT(structure_stack_.size() > 0);
+        auto first = element_stack_.begin() + structure_stack_.back().offset_;
+        structure_stack_.pop_back();
+
+        array elements(std::make_move_iterator(first),
+                       std::make_move_iterator(element_stack_.end()),
+                       array_allocator_);
+        element_stack_.erase(first, element_stack_.end());
+        end_structure(Json(std::move(elements)));
     }
 
-    void end_structure() 
+    void do_name(const string_view_type& name, const parsing_context&) override
     {
-        JSONCONS_ASSERT(stack_offsets_.size() > 0);
-        const size_t structure_index = stack_offsets_.back().offset_;
-        JSONCONS_ASSERT(stack_.size() > structure_index);
-        const size_t count = stack_.size() - (structure_index + 1);
-
-        auto first = stack_.begin() + (structure_index+1);
-        auto last = first + count;
-        if (stack_offsets_.back().is_object_)
+        if (intern_keys_ && name.size() > 0)
         {
-            stack_[structure_index].value_.object_value().insert(
-                std::make_move_iterator(first),
-                std::make_move_iterator(last),
-                [](stack_item&& val){return key_value_pair_type(std::move(val.name_),std::move(val.value_));});
+            name_ = intern(name);
         }
         else
         {
-            auto& j = stack_[structure_index].value_;
-            j.reserve(count);
-            while (first != last)
+            name_ = key_storage_type(name.begin(),name.end(),string_allocator_);
+        }
+    }
+
+    key_storage_type intern(const string_view_type& name)
+    {
+        if (interned_keys_.empty())
+        {
+            interned_keys_.resize(64, key_storage_type(string_allocator_));
+        }
+        size_t i = find_slot(interned_keys_, name);
+        if (interned_keys_[i].size() != 0)
+        {
+            return interned_keys_[i];
+        }
+        key_storage_type key(name.begin(),name.end(),string_allocator_);
+        if (interned_count_ < max_interned_keys)
+        {
+            if (2*(interned_count_ + 1) > interned_keys_.size())
             {
-                j.push_back(std::move(first->value_));
-                ++first;
+                std::vector<key_storage_type,key_allocator_type> keys(2*interned_keys_.size(), key_storage_type(string_allocator_));
+                for (auto& k : interned_keys_)
+                {
+                    if (k.size() != 0)
+                    {
+                        keys[find_slot(keys, string_view_type(k.data(),k.size()))] = std::move(k);
+                    }
+                }
+                interned_keys_.swap(keys);
+                i = find_slot(interned_keys_, name);
             }
+            interned_keys_[i] = key;
+            ++interned_count_;
         }
+        return key;
     }
 
-    void do_name(const string_view_type& name, const parsing_context&) override
+    // Returns the slot holding name, or the empty slot where it belongs
+    static size_t find_slot(const std::vector<key_storage_type,key_allocator_type>& keys, const string_view_type& name)
     {
-        stack_.push_back(key_storage_type(name.begin(),name.end(),string_allocator_));
+        const size_t mask = keys.size() - 1;
+        size_t i = detail::hash_chars(name.data(),name.size()) & mask;
+        while (keys[i].size() != 0 && string_view_type(keys[i].data(),keys[i].size()) != name)
+        {
+            i = (i + 1) & mask;
+        }
+        return i;
     }
 
     void do_string_value(const string_view_type& val, const parsing_context&) override
     {
-        if (stack_offsets_.back().is_object_)
+        if (reference_strings_)
         {
-            stack_.back().value_ = Json(val.data(),val.length(),string_allocator_);
+            add_value(Json::make_string_reference(val.data(),val.length()));
         }
         else
         {
-            stack_.push_back(Json(val.data(),val.length(),string_allocator_));
+            add_value(Json(val.data(),val.length(),string_allocator_));
         }
     }
 
     void do_byte_string_value(const uint8_t* data, size_t length, const parsing_context&) override
     {
-        if (stack_offsets_.back().is_object_)
-        {
-            stack_.back().value_ = Json(data,length,string_allocator_);
-        }
-        else
-        {
-            stack_.push_back(Json(data,length,string_allocator_));
-        }
+        add_value(Json(data,length,string_allocator_));
     }
 
     void do_integer_value(int64_t value, const parsing_context&) override
     {
-        if (stack_offsets_.back().is_object_)
-        {
-            stack_.back().value_ = value;
-        }
-        else
-        {
-            stack_.push_back(Json(value));
-        }
+        add_value(value);
     }
 
     void do_uinteger_value(uint64_t value, const parsing_context&) override
     {
-        if (stack_offsets_.back().is_object_)
-        {
-            stack_.back().value_ = value;
-        }
-        else
-        {
-            stack_.push_back(Json(value));
-        }
+        add_value(value);
     }
 
     void do_double_value(double value, const number_format& fmt, const parsing_context&) override
     {
-        if (stack_offsets_.back().is_object_)
+        add_value(Json(value,fmt));
+    }
+
+    void do_number_value(const string_view_type& val, const parsing_context&) override
+    {
+        if (lazy_numbers_)
         {
-            stack_.back().value_ = Json(value,fmt);
+            add_value(Json::make_number_text(val.data(),val.length(),string_allocator_));
         }
         else
         {
-            stack_.push_back(Json(value,fmt));
+            add_value(Json(detail::number_text_to_double(val.data(),val.length()),
+                           detail::number_text_format(val.data(),val.length())));
         }
     }
 
+    bool do_accepts_number_text() const override
+    {
+        return lazy_numbers_;
+    }
+
     void do_bool_value(bool value, const parsing_context&) override
     {
-        if (stack_offsets_.back().is_object_)
-        {
-            stack_.back().value_ = value;
-        }
-        else
-        {
-            stack_.push_back(Json(value));
-        }
+        add_value(value);
     }
 
     void do_null_value(const parsing_context&) override
     {
-        if (stack_offsets_.back().is_object_)
-        {
-            stack_.back().value_ = Json::null();
-        }
-        else
-        {
-            stack_.push_back(Json(Json::null()));
-        }
+        add_value(Json::null());
     }
 };
 
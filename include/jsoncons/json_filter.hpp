@@ -116,6 +116,11 @@ private:
         output_handler_.double_value(value, fmt);
     }
 
+    void do_number_value(const string_view_type& value, const parsing_context&) override
+    {
+        output_handler_.number_value(value);
+    }
+
     void do_bool_value(bool value, const parsing_context&) override
     {
         output_handler_.bool_value(value);
@@ -240,6 +245,11 @@ private:
         input_handler_.double_value(value, fmt, default_context_);
     }
 
+    void do_number_value(const string_view_type& value) override
+    {
+        input_handler_.number_value(value, default_context_);
+    }
+
     void do_bool_value(bool value) override
     {
         input_handler_.bool_value(value, default_context_);
@@ -363,6 +373,17 @@ private:
         downstream_handler_.double_value(value, fmt, context);
     }
 
+    void do_number_value(const string_view_type& value,
+                 const parsing_context& context) override
+    {
+        downstream_handler_.number_value(value, context);
+    }
+
+    bool do_accepts_number_text() const override
+    {
+        return downstream_handler_.accepts_number_text();
+    }
+
     void do_integer_value(int64_t value,
                  const parsing_context& context) override
     {
@@ -0,0 +1,785 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_INDEX_PARSER_HPP
+#define JSONCONS_JSON_INDEX_PARSER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_input_handler.hpp>
+#include <jsoncons/parse_error_handler.hpp>
+#include <jsoncons/json_error_category.hpp>
+#include <jsoncons/detail/number_parsers.hpp>
+#include <jsoncons/detail/char_scanners.hpp>
+#include <jsoncons/detail/structural_index.hpp>
+
+namespace jsoncons {
+
+// basic_json_index_parser
+// Parses a complete JSON text held in memory in two passes. The first builds an index
+// of token positions a block at a time, the second walks the index and emits events
+// to the handler. Strict JSON only, and every error is fatal: there is no
+// parse_error_handler and no recovery, comments are rejected.
+
+template <class CharT,class Allocator=std::allocator<char>>
+class basic_json_index_parser : private parsing_context
+{
+    typedef typename basic_json_input_handler<CharT>::string_view_type string_view_type;
+
+    enum class structure_type : uint8_t {object_t, array_t};
+
+    typedef Allocator allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<CharT> char_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<char> numeral_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint32_t> index_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<structure_type> structure_allocator_type;
+
+    basic_null_json_input_handler<CharT> default_input_handler_;
+    basic_json_input_handler<CharT>& handler_;
+
+    std::vector<uint32_t,index_allocator_type> index_;
+    std::vector<structure_type,structure_allocator_type> stack_;
+    std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type> string_buffer_;
+    std::basic_string<char,std::char_traits<char>,numeral_allocator_type> number_buffer_;
+    detail::string_to_double to_double_;
+
+    int max_depth_;
+    const CharT* begin_input_;
+    const CharT* end_input_;
+    CharT* insitu_input_;
+    size_t position_;
+    bool is_ascii_;
+
+    // line and column are computed from position_ on demand
+    mutable size_t line_;
+    mutable size_t line_begin_;
+    mutable size_t counted_;
+
+    // Noncopyable and nonmoveable
+    basic_json_index_parser(const basic_json_index_parser&) = delete;
+    basic_json_index_parser& operator=(const basic_json_index_parser&) = delete;
+
+public:
+    basic_json_index_parser()
+       : handler_(default_input_handler_),
+         max_depth_((std::numeric_limits<int>::max)()),
+         begin_input_(nullptr),
+         end_input_(nullptr),
+         insitu_input_(nullptr),
+         position_(0),
+         is_ascii_(false),
+         line_(1),
+         line_begin_(0),
+         counted_(0)
+    {
+    }
+
+    basic_json_index_parser(basic_json_input_handler<CharT>& handler)
+       : handler_(handler),
+         max_depth_((std::numeric_limits<int>::max)()),
+         begin_input_(nullptr),
+         end_input_(nullptr),
+         insitu_input_(nullptr),
+         position_(0),
+         is_ascii_(false),
+         line_(1),
+         line_begin_(0),
+         counted_(0)
+    {
+    }
+
+    size_t max_nesting_depth() const
+    {
+        return static_cast<size_t>(max_depth_);
+    }
+
+    void max_nesting_depth(size_t max_nesting_depth)
+    {
+        max_depth_ = static_cast<int>((std::min)(max_nesting_depth,static_cast<size_t>((std::numeric_limits<int>::max)())));
+    }
+
+    const parsing_context& parsing_context() const
+    {
+        return *this;
+    }
+
+    size_t line_number() const
+    {
+        return do_line_number();
+    }
+
+    size_t column_number() const
+    {
+        return do_column_number();
+    }
+
+    void parse(const CharT* input, size_t length)
+    {
+        std::error_code ec;
+        parse(input, length, ec);
+        if (ec)
+        {
+            throw parse_error(ec,line_number(),column_number());
+        }
+    }
+
+    // parse_insitu
+    // Like parse, but decodes escapes into input itself and null terminates every string
+    // there, so that all string and name events refer to input. The contents of input
+    // after parsing are unspecified apart from those strings, and the line numbers of
+    // errors may be affected by decoded escapes.
+
+    void parse_insitu(CharT* input, size_t length)
+    {
+        std::error_code ec;
+        parse_insitu(input, length, ec);
+        if (ec)
+        {
+            throw parse_error(ec,line_number(),column_number());
+        }
+    }
+
+    void parse_insitu(CharT* input, size_t length, std::error_code& ec)
+    {
+        parse_text(input, length, input, ec);
+    }
+
+    void parse(const CharT* input, size_t length, std::error_code& ec)
+    {
+        parse_text(input, length, nullptr, ec);
+    }
+
+private:
+
+    void parse_text(const CharT* input, size_t length, CharT* insitu_input, std::error_code& ec)
+    {
+        begin_input_ = input;
+        insitu_input_ = insitu_input;
+        end_input_ = input + length;
+        position_ = 0;
+        line_ = 1;
+        line_begin_ = 0;
+        counted_ = 0;
+
+        if (length > (std::numeric_limits<uint32_t>::max)())
+        {
+            ec = json_parser_errc::source_error;
+            return;
+        }
+
+        index_.clear();
+        stack_.clear();
+        // An unterminated string is reported by the walk below
+        is_ascii_ = detail::build_structural_index(input, length, index_).is_ascii;
+
+        const uint32_t* it = index_.data();
+        const uint32_t* end = it + index_.size();
+        int nesting_depth = 0;
+
+        handler_.begin_json();
+
+value:
+        if (it == end)
+        {
+            position_ = length;
+            ec = json_parser_errc::unexpected_eof;
+            return;
+        }
+        position_ = *it++;
+        switch (begin_input_[position_])
+        {
+            case '{':
+                if (++nesting_depth >= max_depth_)
+                {
+                    ec = json_parser_errc::max_depth_exceeded;
+                    return;
+                }
+                handler_.begin_object(*this);
+                if (it != end && begin_input_[*it] == '}')
+                {
+                    position_ = *it++;
+                    --nesting_depth;
+                    handler_.end_object(*this);
+                    goto after_value;
+                }
+                stack_.push_back(structure_type::object_t);
+                goto member_name;
+            case '[':
+                if (++nesting_depth >= max_depth_)
+                {
+                    ec = json_parser_errc::max_depth_exceeded;
+                    return;
+                }
+                handler_.begin_array(*this);
+                if (it != end && begin_input_[*it] == ']')
+                {
+                    position_ = *it++;
+                    --nesting_depth;
+                    handler_.end_array(*this);
+                    goto after_value;
+                }
+                stack_.push_back(structure_type::array_t);
+                goto value;
+            case '\"':
+            {
+                string_view_type sv = parse_string(ec);
+                if (ec) return;
+                handler_.string_value(sv, *this);
+                goto after_value;
+            }
+            case '-':
+            case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                parse_number(ec);
+                if (ec) return;
+                goto after_value;
+            case 't':
+                parse_literal("true", ec);
+                if (ec) return;
+                handler_.bool_value(true, *this);
+                goto after_value;
+            case 'f':
+                parse_literal("false", ec);
+                if (ec) return;
+                handler_.bool_value(false, *this);
+                goto after_value;
+            case 'n':
+                parse_literal("null", ec);
+                if (ec) return;
+                handler_.null_value(*this);
+                goto after_value;
+            case ']':
+                ec = stack_.empty() ? json_parser_errc::unexpected_right_bracket : json_parser_errc::extra_comma;
+                return;
+            case '}':
+                ec = stack_.empty() ? json_parser_errc::unexpected_right_brace : json_parser_errc::expected_value;
+                return;
+            case '\'':
+                ec = json_parser_errc::single_quote;
+                return;
+            default:
+                ec = stack_.empty() ? json_parser_errc::invalid_json_text : json_parser_errc::expected_value;
+                return;
+        }
+
+member_name:
+        if (it == end)
+        {
+            position_ = length;
+            ec = json_parser_errc::unexpected_eof;
+            return;
+        }
+        position_ = *it++;
+        switch (begin_input_[position_])
+        {
+            case '\"':
+            {
+                string_view_type sv = parse_string(ec);
+                if (ec) return;
+                handler_.name(sv, *this);
+                break;
+            }
+            case '}':
+                ec = json_parser_errc::extra_comma;
+                return;
+            case '\'':
+                ec = json_parser_errc::single_quote;
+                return;
+            default:
+                ec = json_parser_errc::expected_name;
+                return;
+        }
+        if (it == end)
+        {
+            position_ = length;
+            ec = json_parser_errc::unexpected_eof;
+            return;
+        }
+        position_ = *it++;
+        if (begin_input_[position_] != ':')
+        {
+            ec = json_parser_errc::expected_colon;
+            return;
+        }
+        goto value;
+
+after_value:
+        if (stack_.empty())
+        {
+            handler_.end_json();
+            if (it != end)
+            {
+                position_ = *it;
+                ec = json_parser_errc::extra_character;
+            }
+            return;
+        }
+        if (it == end)
+        {
+            position_ = length;
+            ec = json_parser_errc::unexpected_eof;
+            return;
+        }
+        position_ = *it++;
+        switch (begin_input_[position_])
+        {
+            case ',':
+                if (stack_.back() == structure_type::object_t)
+                {
+                    goto member_name;
+                }
+                goto value;
+            case '}':
+                if (stack_.back() != structure_type::object_t)
+                {
+                    ec = json_parser_errc::expected_comma_or_right_bracket;
+                    return;
+                }
+                stack_.pop_back();
+                --nesting_depth;
+                handler_.end_object(*this);
+                goto after_value;
+            case ']':
+                if (stack_.back() != structure_type::array_t)
+                {
+                    ec = json_parser_errc::expected_comma_or_right_brace;
+                    return;
+                }
+                stack_.pop_back();
+                --nesting_depth;
+                handler_.end_array(*this);
+                goto after_value;
+            default:
+                ec = stack_.back() == structure_type::object_t
+                    ? json_parser_errc::expected_comma_or_right_brace
+                    : json_parser_errc::expected_comma_or_right_bracket;
+                return;
+        }
+    }
+
+    static bool is_separator(CharT c)
+    {
+        switch (c)
+        {
+            case ' ':case '\t':case '\n':case '\r':
+            case '{':case '}':case '[':case ']':case ':':case ',':case '\"':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static bool is_digit(CharT c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    void parse_literal(const char* literal, std::error_code& ec)
+    {
+        const CharT* p = begin_input_ + position_;
+        for (; *literal != 0; ++literal, ++p)
+        {
+            if (p == end_input_ || *p != *literal)
+            {
+                ec = json_parser_errc::invalid_value;
+                return;
+            }
+        }
+        if (p != end_input_ && !is_separator(*p))
+        {
+            ec = json_parser_errc::invalid_value;
+        }
+    }
+
+    void parse_number(std::error_code& ec)
+    {
+        const CharT* s = begin_input_ + position_;
+        const CharT* p = s;
+
+        bool is_negative = *p == '-';
+        if (is_negative)
+        {
+            ++p;
+        }
+        const CharT* integer_begin = p;
+        if (p == end_input_ || !is_digit(*p))
+        {
+            ec = json_parser_errc::expected_value;
+            return;
+        }
+        if (*p == '0')
+        {
+            ++p;
+            if (p != end_input_ && is_digit(*p))
+            {
+                ec = json_parser_errc::leading_zero;
+                return;
+            }
+        }
+        else
+        {
+            while (p != end_input_ && is_digit(*p))
+            {
+                ++p;
+            }
+        }
+        const CharT* integer_end = p;
+        size_t precision = static_cast<size_t>(integer_end - integer_begin);
+        uint8_t decimal_places = 0;
+
+        bool is_integer = true;
+        chars_format format = chars_format::fixed;
+        if (p != end_input_ && *p == '.')
+        {
+            is_integer = false;
+            const CharT* fraction_begin = ++p;
+            while (p != end_input_ && is_digit(*p))
+            {
+                ++p;
+            }
+            if (p == fraction_begin)
+            {
+                ec = json_parser_errc::invalid_number;
+                return;
+            }
+            precision += static_cast<size_t>(p - fraction_begin);
+            decimal_places = static_cast<uint8_t>(p - fraction_begin);
+        }
+        if (p != end_input_ && (*p == 'e' || *p == 'E'))
+        {
+            is_integer = false;
+            format = chars_format::scientific;
+            ++p;
+            if (p != end_input_ && (*p == '+' || *p == '-'))
+            {
+                ++p;
+            }
+            const CharT* exponent_begin = p;
+            while (p != end_input_ && is_digit(*p))
+            {
+                ++p;
+            }
+            if (p == exponent_begin)
+            {
+                ec = json_parser_errc::expected_value;
+                return;
+            }
+        }
+        if (p != end_input_ && !is_separator(*p))
+        {
+            ec = json_parser_errc::invalid_number;
+            return;
+        }
+
+        if (is_integer)
+        {
+            if (is_negative)
+            {
+                auto result = detail::to_integer(s, p - s);
+                if (!result.overflow)
+                {
+                    handler_.integer_value(result.value, *this);
+                    return;
+                }
+            }
+            else
+            {
+                auto result = detail::to_uinteger(s, p - s);
+                if (!result.overflow)
+                {
+                    handler_.uinteger_value(result.value, *this);
+                    return;
+                }
+            }
+            format = chars_format::general;
+        }
+
+        if (handler_.accepts_number_text())
+        {
+            handler_.number_value(string_view_type(s, p - s), *this);
+            return;
+        }
+
+        double d;
+        if (!detail::decimal_to_double(integer_begin, p - integer_begin, d))
+        {
+            number_buffer_.clear();
+            for (const CharT* q = integer_begin; q != p; ++q)
+            {
+                number_buffer_.push_back(*q == '.' ? to_double_.get_decimal_point() : static_cast<char>(*q));
+            }
+            try
+            {
+                d = to_double_(number_buffer_.c_str(), number_buffer_.length());
+            }
+            catch (...)
+            {
+                ec = json_parser_errc::invalid_number;
+                return;
+            }
+        }
+        if (is_negative)
+        {
+            d = -d;
+        }
+        const size_t max_digits10 = std::numeric_limits<double>::max_digits10;
+        handler_.double_value(d, number_format(format, static_cast<uint8_t>((std::min)(precision, max_digits10)), decimal_places), *this);
+    }
+
+    string_view_type parse_string(std::error_code& ec)
+    {
+        const CharT* first = begin_input_ + position_ + 1;
+        const CharT* p = detail::find_string_special(first, end_input_);
+        if (p != end_input_ && *p == '\"')
+        {
+            // No escapes, the value refers to the input
+            if (!validate(first, p, ec))
+            {
+                return string_view_type();
+            }
+            if (insitu_input_ != nullptr)
+            {
+                insitu_input_[p - begin_input_] = 0;
+            }
+            return string_view_type(first, p - first);
+        }
+
+        string_buffer_.clear();
+        const CharT* sb = first;
+        for (;;)
+        {
+            if (p == end_input_)
+            {
+                position_ = end_input_ - begin_input_;
+                ec = json_parser_errc::unexpected_eof;
+                return string_view_type();
+            }
+            switch (*p)
+            {
+                case '\"':
+                    if (!validate(sb, p, ec))
+                    {
+                        return string_view_type();
+                    }
+                    string_buffer_.append(sb, p - sb);
+                    if (insitu_input_ != nullptr)
+                    {
+                        // The decoded string is never longer than its escaped form
+                        CharT* target = insitu_input_ + (first - begin_input_);
+                        std::copy(string_buffer_.begin(), string_buffer_.end(), target);
+                        target[string_buffer_.length()] = 0;
+                        return string_view_type(target, string_buffer_.length());
+                    }
+                    return string_view_type(string_buffer_.data(), string_buffer_.length());
+                case '\\':
+                    if (!validate(sb, p, ec))
+                    {
+                        return string_view_type();
+                    }
+                    string_buffer_.append(sb, p - sb);
+                    p = unescape(p + 1, ec);
+                    if (ec)
+                    {
+                        return string_view_type();
+                    }
+                    sb = p;
+                    break;
+                case '\r':
+                case '\n':
+                case '\t':
+                    position_ = p - begin_input_;
+                    ec = json_parser_errc::illegal_character_in_string;
+                    return string_view_type();
+                default:
+                    position_ = p - begin_input_;
+                    ec = json_parser_errc::illegal_control_character;
+                    return string_view_type();
+            }
+            p = detail::find_string_special(p, end_input_);
+        }
+    }
+
+    bool validate(const CharT* first, const CharT* last, std::error_code& ec)
+    {
+        if (is_ascii_)
+        {
+            return true;
+        }
+        auto result = unicons::validate(first, last);
+        if (result.ec == unicons::conv_errc())
+        {
+            return true;
+        }
+        position_ = result.it - begin_input_;
+        switch (result.ec)
+        {
+            case unicons::conv_errc::over_long_utf8_sequence:
+                ec = json_parser_errc::over_long_utf8_sequence;
+                break;
+            case unicons::conv_errc::unpaired_high_surrogate:
+                ec = json_parser_errc::unpaired_high_surrogate;
+                break;
+            case unicons::conv_errc::expected_continuation_byte:
+                ec = json_parser_errc::expected_continuation_byte;
+                break;
+            case unicons::conv_errc::illegal_surrogate_value:
+                ec = json_parser_errc::illegal_surrogate_value;
+                break;
+            default:
+                ec = json_parser_errc::illegal_codepoint;
+                break;
+        }
+        return false;
+    }
+
+    // p points past the reverse solidus, returns a pointer past the escape sequence
+    const CharT* unescape(const CharT* p, std::error_code& ec)
+    {
+        if (p == end_input_)
+        {
+            position_ = p - begin_input_;
+            ec = json_parser_errc::unexpected_eof;
+            return p;
+        }
+        switch (*p)
+        {
+            case '\"':
+            case '\\':
+            case '/':
+                string_buffer_.push_back(*p);
+                return p + 1;
+            case 'b':
+                string_buffer_.push_back('\b');
+                return p + 1;
+            case 'f':
+                string_buffer_.push_back('\f');
+                return p + 1;
+            case 'n':
+                string_buffer_.push_back('\n');
+                return p + 1;
+            case 'r':
+                string_buffer_.push_back('\r');
+                return p + 1;
+            case 't':
+                string_buffer_.push_back('\t');
+                return p + 1;
+            case 'u':
+            {
+                uint32_t cp = read_hex4(++p, ec);
+                if (ec) return p;
+                p += 4;
+                if (unicons::is_high_surrogate(cp))
+                {
+                    if (end_input_ - p < 2 || p[0] != '\\' || p[1] != 'u')
+                    {
+                        position_ = p - begin_input_;
+                        ec = json_parser_errc::expected_codepoint_surrogate_pair;
+                        return p;
+                    }
+                    p += 2;
+                    uint32_t cp2 = read_hex4(p, ec);
+                    if (ec) return p;
+                    p += 4;
+                    cp = 0x10000 + ((cp & 0x3FF) << 10) + (cp2 & 0x3FF);
+                }
+                unicons::convert(&cp, &cp + 1, std::back_inserter(string_buffer_));
+                return p;
+            }
+            default:
+                position_ = p - begin_input_;
+                ec = json_parser_errc::illegal_escaped_character;
+                return p;
+        }
+    }
+
+    uint32_t read_hex4(const CharT* p, std::error_code& ec)
+    {
+        uint32_t cp = 0;
+        for (int i = 0; i < 4; ++i, ++p)
+        {
+            if (p == end_input_)
+            {
+                position_ = p - begin_input_;
+                ec = json_parser_errc::unexpected_eof;
+                return cp;
+            }
+            CharT c = *p;
+            cp *= 16;
+            if (c >= '0' && c <= '9')
+            {
+                cp += c - '0';
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                cp += c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                cp += c - 'A' + 10;
+            }
+            else
+            {
+                position_ = p - begin_input_;
+                ec = json_parser_errc::invalid_hex_escape_sequence;
+                return cp;
+            }
+        }
+        return cp;
+    }
+
+    void count_lines() const
+    {
+        if (position_ < counted_)
+        {
+            line_ = 1;
+            line_begin_ = 0;
+            counted_ = 0;
+        }
+        for (; counted_ < position_; ++counted_)
+        {
+            switch (begin_input_[counted_])
+            {
+                case '\n':
+                    ++line_;
+                    line_begin_ = counted_ + 1;
+                    break;
+                case '\r':
+                    if (counted_ + 1 < position_ && begin_input_[counted_ + 1] == '\n')
+                    {
+                        ++counted_;
+                    }
+                    ++line_;
+                    line_begin_ = counted_ + 1;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    size_t do_line_number() const override
+    {
+        count_lines();
+        return line_;
+    }
+
+    size_t do_column_number() const override
+    {
+        count_lines();
+        return position_ - line_begin_ + 1;
+    }
+};
+
+typedef basic_json_index_parser<char> json_index_parser;
+typedef basic_json_index_parser<wchar_t> wjson_index_parser;
+
+}
+
+#endif
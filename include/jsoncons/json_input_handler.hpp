@@ -10,6 +10,7 @@
 #include <string>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/jsoncons_utilities.hpp>
+#include <jsoncons/detail/number_parsers.hpp>
 #if !defined(JSONCONS_NO_DEPRECATED)
 #include <jsoncons/json_type_traits.hpp> // for null_type
 #endif
@@ -111,6 +112,20 @@ public:
         do_double_value(value, fmt, context);
     }
 
+    // number_value
+    // The text of a number token that has a fraction or an exponent, or does not fit a
+    // 64 bit integer. Unless overridden, it is converted and reported as a double.
+    void number_value(const string_view_type& value, const parsing_context& context)
+    {
+        do_number_value(value, context);
+    }
+
+    // Whether the parsers should report such numbers with number_value instead of converting them
+    bool accepts_number_text() const
+    {
+        return do_accepts_number_text();
+    }
+
     void bool_value(bool value, const parsing_context& context) 
     {
         do_bool_value(value,context);
@@ -227,6 +242,18 @@ private:
 
     virtual void do_double_value(double value, const number_format& fmt, const parsing_context& context) = 0;
 
+    virtual void do_number_value(const string_view_type& value, const parsing_context& context)
+    {
+        do_double_value(detail::number_text_to_double(value.data(), value.length()),
+                        detail::number_text_format(value.data(), value.length()),
+                        context);
+    }
+
+    virtual bool do_accepts_number_text() const
+    {
+        return false;
+    }
+
     virtual void do_integer_value(int64_t value, const parsing_context& context) = 0;
 
     virtual void do_uinteger_value(uint64_t value, const parsing_context& context) = 0;
@@ -10,6 +10,7 @@
 #include <string>
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/jsoncons_utilities.hpp>
+#include <jsoncons/detail/number_parsers.hpp>
 #if !defined(JSONCONS_NO_DEPRECATED)
 #include <jsoncons/json_type_traits.hpp> // for null_type
 #endif
@@ -109,6 +110,14 @@ public:
         do_double_value(value, fmt);
     }
 
+    // number_value
+    // The text of a number token. Serializers write it as it is, other handlers receive
+    // it converted to a double unless they override do_number_value.
+    void number_value(const string_view_type& value)
+    {
+        do_number_value(value);
+    }
+
     void bool_value(bool value) 
     {
         do_bool_value(value);
@@ -221,6 +230,12 @@ private:
 
     virtual void do_double_value(double value, const number_format& fmt) = 0;
 
+    virtual void do_number_value(const string_view_type& value)
+    {
+        do_double_value(detail::number_text_to_double(value.data(), value.length()),
+                        detail::number_text_format(value.data(), value.length()));
+    }
+
     virtual void do_integer_value(int64_t value) = 0;
 
     virtual void do_uinteger_value(uint64_t value) = 0;
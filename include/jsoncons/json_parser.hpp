@@ -20,6 +20,7 @@
 #include <jsoncons/parse_error_handler.hpp>
 #include <jsoncons/json_error_category.hpp>
 #include <jsoncons/detail/number_parsers.hpp>
+#include <jsoncons/detail/char_scanners.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -75,6 +76,9 @@ enum class parse_state : uint8_t
     fa,  
     fal,  
     fals,  
+    skip_value,
+    skip_string,
+    skip_escape,
     cr,
     lf,
     done
@@ -121,6 +125,10 @@ class basic_json_parser : private parsing_context
     parse_state state_;
     typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<parse_state> parse_state_allocator_type;
     std::vector<parse_state,parse_state_allocator_type> state_stack_;
+    bool continue_;
+    mutable bool skip_requested_;
+    bool skip_contents_;
+    int skip_depth_;
 
     // Noncopyable and nonmoveable
     basic_json_parser(const basic_json_parser&) = delete;
@@ -143,7 +151,11 @@ public:
          begin_input_(nullptr),
          input_end_(nullptr),
          input_ptr_(nullptr),
-         state_(parse_state::start)
+         state_(parse_state::start),
+         continue_(true),
+         skip_requested_(false),
+         skip_contents_(false),
+         skip_depth_(0)
     {
         string_buffer_.reserve(initial_string_buffer_capacity_);
         number_buffer_.reserve(initial_number_buffer_capacity_);
@@ -168,7 +180,11 @@ public:
          begin_input_(nullptr),
          input_end_(nullptr),
          input_ptr_(nullptr),
-         state_(parse_state::start)
+         state_(parse_state::start),
+         continue_(true),
+         skip_requested_(false),
+         skip_contents_(false),
+         skip_depth_(0)
     {
         string_buffer_.reserve(initial_string_buffer_capacity_);
         number_buffer_.reserve(initial_number_buffer_capacity_);
@@ -193,7 +209,11 @@ public:
          begin_input_(nullptr),
          input_end_(nullptr),
          input_ptr_(nullptr),
-         state_(parse_state::start)
+         state_(parse_state::start),
+         continue_(true),
+         skip_requested_(false),
+         skip_contents_(false),
+         skip_depth_(0)
     {
         string_buffer_.reserve(initial_string_buffer_capacity_);
         number_buffer_.reserve(initial_number_buffer_capacity_);
@@ -219,7 +239,11 @@ public:
          begin_input_(nullptr),
          input_end_(nullptr),
          input_ptr_(nullptr),
-         state_(parse_state::start)
+         state_(parse_state::start),
+         continue_(true),
+         skip_requested_(false),
+         skip_contents_(false),
+         skip_depth_(0)
     {
         string_buffer_.reserve(initial_string_buffer_capacity_);
         number_buffer_.reserve(initial_number_buffer_capacity_);
@@ -279,23 +303,61 @@ public:
         return state_ == parse_state::done;
     }
 
+    bool stopped() const
+    {
+        return !continue_;
+    }
+
+    // Called from a handler, makes parse_some return once the current event has been
+    // reported, leaving the rest of the source to be parsed after restart()
+    void stop()
+    {
+        continue_ = false;
+    }
+
+    void restart()
+    {
+        continue_ = true;
+    }
+
     void skip_whitespace()
     {
         const CharT* local_input_end = input_end_;
         for (;;) 
         {
+            const CharT* p = detail::skip_blanks(input_ptr_, local_input_end);
+            column_ += (p - input_ptr_);
+            input_ptr_ = p;
             if (JSONCONS_UNLIKELY(input_ptr_ == local_input_end)) 
             {
                 return;
             } 
-            else if (*input_ptr_ == ' ' || *input_ptr_ == '\t') 
-            {
-                ++input_ptr_;
-                ++column_;                     
-            } 
-            else 
+            switch (*input_ptr_)
             {
-                return;
+                case '\n':
+                    ++input_ptr_;
+                    ++line_;
+                    column_ = 1;
+                    break;
+                case '\r':
+                    ++input_ptr_;
+                    if (JSONCONS_UNLIKELY(input_ptr_ == local_input_end))
+                    {
+                        // The '\n' of a CR LF pair may start the next source chunk
+                        ++column_;
+                        push_state(state_);
+                        state_ = parse_state::cr;
+                        return;
+                    }
+                    if (*input_ptr_ == '\n')
+                    {
+                        ++input_ptr_;
+                    }
+                    ++line_;
+                    column_ = 1;
+                    break;
+                default:
+                    return;
             }
         }
     }
@@ -312,7 +374,12 @@ public:
         } 
         push_state(parse_state::object);
         state_ = parse_state::expect_member_name_or_end;
+        skip_requested_ = false;
         handler_.begin_object(*this);
+        if (skip_requested_)
+        {
+            begin_skip(true);
+        }
     }
 
     void do_end_object(std::error_code& ec)
@@ -360,7 +427,12 @@ public:
         }
         push_state(parse_state::array);
         state_ = parse_state::expect_value_or_end;
+        skip_requested_ = false;
         handler_.begin_array(*this);
+        if (skip_requested_)
+        {
+            begin_skip(true);
+        }
     }
 
     void do_end_array(std::error_code& ec)
@@ -403,6 +475,8 @@ public:
         line_ = 1;
         column_ = 1;
         nesting_depth_ = 0;
+        continue_ = true;
+        skip_requested_ = false;
     }
 
     void check_done()
@@ -450,7 +524,7 @@ public:
     {
         const CharT* local_input_end = input_end_;
 
-        while ((input_ptr_ < local_input_end) && (state_ != parse_state::done))
+        while ((input_ptr_ < local_input_end) && (state_ != parse_state::done) && continue_)
         {
             switch (state_)
             {
@@ -473,6 +547,11 @@ public:
                 column_ = 1;
                 state_ = pop_state();
                 break;
+            case parse_state::skip_value:
+            case parse_state::skip_string:
+            case parse_state::skip_escape:
+                skip_some();
+                break;
             case parse_state::start: 
                 {
                     handler_.begin_json();
@@ -485,19 +564,7 @@ public:
                                 return;
                             }
                             break;
-                        case '\r': 
-                            push_state(state_);
-                            ++input_ptr_;
-                            ++column_;
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case ' ':case '\t':case '\n':case '\r':
                             skip_whitespace();
                             break;
                         case '/': 
@@ -519,6 +586,7 @@ public:
                             ++column_;
                             break;
                         case '\"':
+                            string_buffer_.clear();
                             state_ = parse_state::string_u1;
                             ++input_ptr_;
                             ++column_;
@@ -596,19 +664,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case ' ':case '\t':case '\n':case '\r':
                             skip_whitespace();
                             break;
                         case '/':
@@ -671,19 +727,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case ' ':case '\t':case '\n':case '\r':
                             skip_whitespace();
                             break;
                         case '/':
@@ -702,6 +746,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             push_state(parse_state::member_name);
+                            string_buffer_.clear();
                             state_ = parse_state::string_u1;
                             break;
                         case '\'':
@@ -738,19 +783,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case ' ':case '\t':case '\n':case '\r':
                             skip_whitespace();
                             break;
                         case '/': 
@@ -763,6 +796,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             push_state(parse_state::member_name);
+                            string_buffer_.clear();
                             state_ = parse_state::string_u1;
                             break;
                         case '}':
@@ -810,19 +844,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            push_state(state_);
-                            state_ = parse_state::cr;
-                            ++input_ptr_;
-                            ++column_;
-                            break; 
-                        case '\n': 
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            ++input_ptr_;
-                            ++column_;
-                            break;   
-                        case ' ':case '\t':
+                        case ' ':case '\t':case '\n':case '\r':
                             skip_whitespace();
                             break;
                         case '/': 
@@ -862,19 +884,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            push_state(state_);
-                            ++input_ptr_;
-                            ++column_;
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            push_state(state_);
-                            ++input_ptr_;
-                            ++column_;
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case ' ':case '\t':case '\n':case '\r':
                             skip_whitespace();
                             break;
                         case '/': 
@@ -898,6 +908,7 @@ public:
                         case '\"':
                             ++input_ptr_;
                             ++column_;
+                            string_buffer_.clear();
                             state_ = parse_state::string_u1;
                             break;
                         case '-':
@@ -1000,19 +1011,7 @@ public:
                             ++input_ptr_;
                             ++column_;
                             break;
-                        case '\r': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::cr;
-                            break; 
-                        case '\n': 
-                            ++input_ptr_;
-                            ++column_;
-                            push_state(state_);
-                            state_ = parse_state::lf;
-                            break;   
-                        case ' ':case '\t':
+                        case ' ':case '\t':case '\n':case '\r':
                             skip_whitespace();
                             break;
                         case '/': 
@@ -1042,6 +1041,7 @@ public:
                         case '\"':
                             ++input_ptr_;
                             ++column_;
+                            string_buffer_.clear();
                             state_ = parse_state::string_u1;
                             break;
                         case '-':
@@ -1552,23 +1552,7 @@ zero:
         }
         switch (*input_ptr_)
         {
-            case '\r': 
-                end_integer_value(ec);
-                if (ec) return;
-                ++input_ptr_;
-                ++column_;
-                push_state(state_);
-                state_ = parse_state::cr;
-                return; 
-            case '\n': 
-                end_integer_value(ec);
-                if (ec) return;
-                push_state(state_);
-                ++input_ptr_;
-                ++column_;
-                state_ = parse_state::lf;
-                return;   
-            case ' ':case '\t':
+            case ' ':case '\t':case '\n':case '\r':
                 end_integer_value(ec);
                 if (ec) return;
                 skip_whitespace();
@@ -1637,23 +1621,7 @@ integer:
         }
         switch (*input_ptr_)
         {
-            case '\r': 
-                end_integer_value(ec);
-                if (ec) return;
-                push_state(state_);
-                ++input_ptr_;
-                ++column_;
-                state_ = parse_state::cr;
-                return; 
-            case '\n': 
-                end_integer_value(ec);
-                if (ec) return;
-                push_state(state_);
-                ++input_ptr_;
-                ++column_;
-                state_ = parse_state::lf;
-                return;   
-            case ' ':case '\t':
+            case ' ':case '\t':case '\n':case '\r':
                 end_integer_value(ec);
                 if (ec) return;
                 skip_whitespace();
@@ -1744,23 +1712,7 @@ fraction2:
         }
         switch (*input_ptr_)
         {
-            case '\r': 
-                end_fraction_value(chars_format::fixed,ec);
-                if (ec) return;
-                push_state(state_);
-                ++input_ptr_;
-                ++column_;
-                state_ = parse_state::cr;
-                return; 
-            case '\n': 
-                end_fraction_value(chars_format::fixed,ec);
-                if (ec) return;
-                push_state(state_);
-                ++input_ptr_;
-                ++column_;
-                state_ = parse_state::lf;
-                return;   
-            case ' ':case '\t':
+            case ' ':case '\t':case '\n':case '\r':
                 end_fraction_value(chars_format::fixed,ec);
                 if (ec) return;
                 skip_whitespace();
@@ -1871,23 +1823,7 @@ exp3:
         }
         switch (*input_ptr_)
         {
-            case '\r': 
-                end_fraction_value(chars_format::scientific,ec);
-                if (ec) return;
-                ++input_ptr_;
-                ++column_;
-                push_state(state_);
-                state_ = parse_state::cr;
-                return; 
-            case '\n': 
-                end_fraction_value(chars_format::scientific,ec);
-                if (ec) return;
-                ++input_ptr_;
-                ++column_;
-                push_state(state_);
-                state_ = parse_state::lf;
-                return;   
-            case ' ':case '\t':
+            case ' ':case '\t':case '\n':case '\r':
                 end_fraction_value(chars_format::scientific,ec);
                 if (ec) return;
                 skip_whitespace();
@@ -1975,6 +1911,9 @@ exp3:
         }
 
 string_u1:
+        // Skip runs of literal content in blocks, the switch below only sees the
+        // character that ends the run
+        input_ptr_ = detail::find_string_special(input_ptr_, local_input_end);
         while (input_ptr_ < local_input_end)
         {
             switch (*input_ptr_)
@@ -2092,6 +2031,8 @@ string_u1:
                         column_ += (result.it - sb);
                         return;
                     }
+                    // No escapes and no chunk boundary since the opening quote, the handler
+                    // gets a view into the source itself
                     if (string_buffer_.length() == 0)
                     {
                         end_string_value(sb,input_ptr_-sb, ec);
@@ -2101,7 +2042,6 @@ string_u1:
                     {
                         string_buffer_.append(sb,input_ptr_-sb);
                         end_string_value(string_buffer_.data(),string_buffer_.length(), ec);
-                        string_buffer_.clear();
                         if (ec) {return;}
                     }
                     column_ += (input_ptr_ - sb + 1);
@@ -2634,29 +2574,47 @@ private:
 
     void end_fraction_value(chars_format format, std::error_code& ec)
     {
-        try
+        if (handler_.accepts_number_text())
         {
-            double d = to_double_(number_buffer_.c_str(), number_buffer_.length());
+            // The token, with its sign and a '.' decimal point, in the string buffer, which
+            // is not in use while a number is parsed
+            string_buffer_.clear();
             if (is_negative_)
-                d = -d;
-
-            if (precision_ > std::numeric_limits<double>::max_digits10)
             {
-                handler_.double_value(d, number_format(format,std::numeric_limits<double>::max_digits10, decimal_places_), *this);
+                string_buffer_.push_back('-');
             }
-            else
+            for (char c : number_buffer_)
             {
-                handler_.double_value(d, number_format(format,static_cast<uint8_t>(precision_), decimal_places_), *this);
+                string_buffer_.push_back(c == to_double_.get_decimal_point() ? '.' : static_cast<CharT>(c));
             }
+            handler_.number_value(string_view_type(string_buffer_.data(),string_buffer_.length()), *this);
         }
-        catch (...)
+        else
         {
-            if (err_handler_.error(json_parser_errc::invalid_number, *this))
+            try
             {
-                ec = json_parser_errc::invalid_number;
-                return;
+                double d = to_double_(number_buffer_.c_str(), number_buffer_.length());
+                if (is_negative_)
+                    d = -d;
+
+                if (precision_ > std::numeric_limits<double>::max_digits10)
+                {
+                    handler_.double_value(d, number_format(format,std::numeric_limits<double>::max_digits10, decimal_places_), *this);
+                }
+                else
+                {
+                    handler_.double_value(d, number_format(format,static_cast<uint8_t>(precision_), decimal_places_), *this);
+                }
+            }
+            catch (...)
+            {
+                if (err_handler_.error(json_parser_errc::invalid_number, *this))
+                {
+                    ec = json_parser_errc::invalid_number;
+                    return;
+                }
+                handler_.null_value(*this); // recovery
             }
-            handler_.null_value(*this); // recovery
         }
 
         switch (parent())
@@ -2725,9 +2683,14 @@ private:
         switch (parent())
         {
         case parse_state::member_name:
+            skip_requested_ = false;
             handler_.name(string_view_type(s, length), *this);
             state_ = pop_state();
             state_ = parse_state::expect_colon;
+            if (skip_requested_)
+            {
+                begin_skip(false);
+            }
             break;
         case parse_state::object:
         case parse_state::array:
@@ -2771,6 +2734,96 @@ private:
         }
     }
 
+    // Skipping a member's value starts after its name and ends before the comma or closing brace
+    // that follows the value. Skipping the contents of an object or array ends before its closing
+    // brace or bracket, which is then reported as usual. Skipped text is only checked for the
+    // nesting of braces and brackets outside strings.
+
+    void begin_skip(bool contents)
+    {
+        skip_requested_ = false;
+        skip_contents_ = contents;
+        skip_depth_ = 0;
+        state_ = parse_state::skip_value;
+    }
+
+    void skip_some()
+    {
+        const CharT* local_input_end = input_end_;
+
+        while (input_ptr_ < local_input_end)
+        {
+            switch (state_)
+            {
+            case parse_state::skip_string:
+                {
+                    const CharT* p = detail::find_string_special(input_ptr_, local_input_end);
+                    column_ += (p - input_ptr_);
+                    input_ptr_ = p;
+                    if (input_ptr_ == local_input_end)
+                    {
+                        return;
+                    }
+                    switch (*input_ptr_)
+                    {
+                    case '\"':
+                        state_ = parse_state::skip_value;
+                        break;
+                    case '\\':
+                        state_ = parse_state::skip_escape;
+                        break;
+                    default:
+                        break;
+                    }
+                    ++input_ptr_;
+                    ++column_;
+                }
+                break;
+            case parse_state::skip_escape:
+                state_ = parse_state::skip_string;
+                ++input_ptr_;
+                ++column_;
+                break;
+            default:
+                switch (*input_ptr_)
+                {
+                case '\"':
+                    state_ = parse_state::skip_string;
+                    break;
+                case '{':
+                case '[':
+                    ++skip_depth_;
+                    break;
+                case '}':
+                case ']':
+                    if (skip_depth_ == 0)
+                    {
+                        state_ = parse_state::expect_comma_or_end;
+                        return;
+                    }
+                    --skip_depth_;
+                    break;
+                case ',':
+                    if (skip_depth_ == 0 && !skip_contents_)
+                    {
+                        state_ = parse_state::expect_comma_or_end;
+                        return;
+                    }
+                    break;
+                case '\n':
+                    ++line_;
+                    column_ = 0;
+                    break;
+                default:
+                    break;
+                }
+                ++input_ptr_;
+                ++column_;
+                break;
+            }
+        }
+    }
+
     void push_state(parse_state state)
     {
         state_stack_.push_back(state);
@@ -2819,6 +2872,12 @@ private:
     {
         return column_;
     }
+
+    bool do_skip_value() const override
+    {
+        skip_requested_ = true;
+        return true;
+    }
 };
 
 typedef basic_json_parser<char> json_parser;
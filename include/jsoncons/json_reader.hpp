@@ -20,6 +20,7 @@
 #include <jsoncons/json_input_handler.hpp>
 #include <jsoncons/parse_error_handler.hpp>
 #include <jsoncons/json_parser.hpp>
+#include <jsoncons/source.hpp>
 
 namespace jsoncons {
 
@@ -136,7 +137,7 @@ private:
     }
 };
 
-template<class CharT,class Allocator=std::allocator<char>>
+template<class CharT,class Allocator=std::allocator<char>,class Src=stream_source<CharT>>
 class basic_json_reader 
 {
     static const size_t default_max_buffer_length = 16384;
@@ -146,7 +147,7 @@ class basic_json_reader
     typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<CharT> char_allocator_type;
 
     basic_json_parser<CharT,Allocator> parser_;
-    std::basic_istream<CharT>& is_;
+    Src source_;
     bool eof_;
     std::vector<CharT,char_allocator_type> buffer_;
     size_t buffer_length_;
@@ -158,9 +159,10 @@ class basic_json_reader
 
 public:
 
-    basic_json_reader(std::basic_istream<CharT>& is)
+    template <class Source>
+    basic_json_reader(Source&& source)
         : parser_(),
-          is_(is),
+          source_(std::forward<Source>(source)),
           eof_(false),
           buffer_length_(default_max_buffer_length),
           begin_(true)
@@ -168,10 +170,11 @@ public:
         buffer_.reserve(buffer_length_);
     }
 
-    basic_json_reader(std::basic_istream<CharT>& is,
+    template <class Source>
+    basic_json_reader(Source&& source,
                       parse_error_handler& err_handler)
        : parser_(err_handler),
-         is_(is),
+         source_(std::forward<Source>(source)),
          eof_(false),
          buffer_length_(default_max_buffer_length),
          begin_(true)
@@ -179,10 +182,11 @@ public:
         buffer_.reserve(buffer_length_);
     }
 
-    basic_json_reader(std::basic_istream<CharT>& is, 
+    template <class Source>
+    basic_json_reader(Source&& source, 
                       basic_json_input_handler<CharT>& handler)
         : parser_(handler),
-          is_(is),
+          source_(std::forward<Source>(source)),
           eof_(false),
           buffer_length_(default_max_buffer_length),
           begin_(true)
@@ -190,11 +194,12 @@ public:
         buffer_.reserve(buffer_length_);
     }
 
-    basic_json_reader(std::basic_istream<CharT>& is,
+    template <class Source>
+    basic_json_reader(Source&& source,
                       basic_json_input_handler<CharT>& handler,
                       parse_error_handler& err_handler)
        : parser_(handler,err_handler),
-         is_(is),
+         source_(std::forward<Source>(source)),
          eof_(false),
          buffer_length_(default_max_buffer_length),
          begin_(true)
@@ -235,29 +240,31 @@ public:
 
     void read_buffer(std::error_code& ec)
     {
-        buffer_.clear();
-        buffer_.resize(buffer_length_);
-        is_.read(buffer_.data(), buffer_length_);
-        buffer_.resize(static_cast<size_t>(is_.gcount()));
-        if (buffer_.size() == 0)
+        if (buffer_.size() != buffer_length_)
+        {
+            buffer_.resize(buffer_length_);
+        }
+        const CharT* data = buffer_.data();
+        size_t length = source_.read_buffer(buffer_.data(), buffer_length_, data);
+        if (length == 0)
         {
             eof_ = true;
         }
         else if (begin_)
         {
-            auto result = unicons::skip_bom(buffer_.begin(), buffer_.end());
+            auto result = unicons::skip_bom(data, data+length);
             if (result.ec != unicons::encoding_errc())
             {
                 ec = result.ec;
                 return;
             }
-            size_t offset = result.it - buffer_.begin();
-            parser_.set_source(buffer_.data()+offset,buffer_.size()-offset);
+            size_t offset = result.it - data;
+            parser_.set_source(data+offset,length-offset);
             begin_ = false;
         }
         else
         {
-            parser_.set_source(buffer_.data(),buffer_.size());
+            parser_.set_source(data,length);
         }
     }
 
@@ -268,9 +275,9 @@ public:
         {
             if (parser_.source_exhausted())
             {
-                if (!is_.eof())
+                if (!source_.eof())
                 {
-                    if (is_.fail())
+                    if (source_.is_error())
                     {
                         ec = json_parser_errc::source_error;
                         return;
@@ -329,9 +336,9 @@ public:
             {
                 if (parser_.source_exhausted())
                 {
-                    if (!is_.eof())
+                    if (!source_.eof())
                     {
-                        if (is_.fail())
+                        if (source_.is_error())
                         {
                             ec = json_parser_errc::source_error;
                             return;
@@ -0,0 +1,108 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSONRECLAIMER_HPP
+#define JSONCONS_JSONRECLAIMER_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <jsoncons/json.hpp>
+
+namespace jsoncons {
+
+// json_reclaimer
+// Destroys values on a thread of its own. reclaim moves a value into a queue, which takes
+// constant time however large the value is, and the thread destroys the queued values.
+
+template <class Json>
+class json_reclaimer
+{
+    std::mutex mutex_;
+    std::condition_variable queued_;
+    std::condition_variable drained_;
+    std::vector<Json> queue_;
+    size_t pending_;
+    bool done_;
+    std::thread thread_;
+
+    // noncopyable and nonmoveable
+    json_reclaimer(const json_reclaimer&) = delete;
+    json_reclaimer& operator=(const json_reclaimer&) = delete;
+public:
+    json_reclaimer()
+        : pending_(0), done_(false)
+    {
+        thread_ = std::thread([this](){run();});
+    }
+
+    // Destroys the values still queued before returning
+    ~json_reclaimer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+        }
+        queued_.notify_one();
+        thread_.join();
+    }
+
+    // Takes the value, leaving null in its place
+    void reclaim(Json&& val)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(val));
+            ++pending_;
+        }
+        queued_.notify_one();
+    }
+
+    void reclaim(Json& val)
+    {
+        reclaim(std::move(val));
+    }
+
+    // Waits until every value reclaimed so far has been destroyed
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        drained_.wait(lock, [this](){return pending_ == 0;});
+    }
+
+private:
+    void run()
+    {
+        std::vector<Json> batch;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
+        {
+            queued_.wait(lock, [this](){return done_ || !queue_.empty();});
+            if (queue_.empty())
+            {
+                break;
+            }
+            batch.swap(queue_);
+            lock.unlock();
+
+            size_t count = batch.size();
+            batch.clear();
+
+            lock.lock();
+            pending_ -= count;
+            if (pending_ == 0)
+            {
+                drained_.notify_all();
+            }
+        }
+    }
+};
+
+}
+
+#endif
@@ -523,6 +523,16 @@ private:
         end_value();
     }
 
+    void do_number_value(const string_view_type& value) override
+    {
+        if (!stack_.empty() && stack_.back().is_array())
+        {
+            begin_scalar_value();
+        }
+        writer_.write(value.data(), value.length());
+        end_value();
+    }
+
     void do_integer_value(int64_t value) override
     {
         if (!stack_.empty() && stack_.back().is_array())
@@ -406,7 +406,7 @@ public:
     {
     }
 
-    key_value_pair(key_value_pair&& member)
+    key_value_pair(key_value_pair&& member) JSONCONS_NOEXCEPT
         : key_(std::move(member.key_)), value_(std::move(member.value_))
     {
     }
@@ -536,6 +536,14 @@ public:
     {
         return this->self_allocator_;
     }
+
+    // Appends members without looking for existing ones with the same names, for building an
+    // object from members that arrive in sequence. normalize() must be called afterwards.
+    template <class InputIt>
+    void insert_unchecked(InputIt first, InputIt last)
+    {
+        members_.insert(members_.end(), first, last);
+    }
 };
 
 // json_object
@@ -718,8 +726,31 @@ public:
         {
             this->members_.emplace_back(pred(*s));
         }
-        std::stable_sort(this->members_.begin(),this->members_.end(),
-                         [](const value_type& a, const value_type& b){return a.key().compare(b.key()) < 0;});
+        normalize();
+    }
+
+    // Sorts the members by name and removes those with duplicate names, keeping the last of each
+    void normalize()
+    {
+        auto out_of_order = std::adjacent_find(this->members_.begin(),this->members_.end(),
+                              [](const value_type& a, const value_type& b){return a.key().compare(b.key()) >= 0;});
+        if (out_of_order == this->members_.end())
+        {
+            return;
+        }
+        auto less = [](const value_type& a, const value_type& b){return a.key().compare(b.key()) < 0;};
+        if (this->members_.size() <= 16)
+        {
+            // A stable insertion sort, std::stable_sort would allocate a buffer
+            for (auto it = out_of_order + 1; it != this->members_.end(); ++it)
+            {
+                std::rotate(std::upper_bound(this->members_.begin(), it, *it, less), it, it + 1);
+            }
+        }
+        else
+        {
+            std::stable_sort(this->members_.begin(),this->members_.end(), less);
+        }
         auto it = std::unique(this->members_.rbegin(), this->members_.rend(),
                               [](const value_type& a, const value_type& b){ return !(a.key().compare(b.key()));});
         this->members_.erase(this->members_.begin(),it.base());
@@ -1275,32 +1306,49 @@ public:
     using typename Json_object_<KeyT,Json>::const_iterator;
     using Json_object_<KeyT,Json>::get_allocator;
 
+    // Objects with at least this many members are looked up through a hash index
+    static const size_t index_threshold = 32;
+private:
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<size_t> index_allocator_type;
+
+    // An open addressing table of member positions plus one, zero marks an empty slot. It is
+    // built when the object reaches index_threshold members, extended as members are appended,
+    // and rebuilt when members are erased or inserted before others, so lookups never modify it.
+    // Reordering members through iterators is not seen by it.
+    std::vector<size_t,index_allocator_type> index_;
+public:
+
     json_object()
         : Json_object_<KeyT,Json>()
     {
     }
     json_object(const allocator_type& allocator)
-        : Json_object_<KeyT,Json>(allocator)
+        : Json_object_<KeyT,Json>(allocator), 
+          index_(index_allocator_type(allocator))
     {
     }
 
     json_object(const json_object& val)
-        : Json_object_<KeyT,Json>(val)
+        : Json_object_<KeyT,Json>(val),
+          index_(val.index_)
     {
     }
 
     json_object(json_object&& val)
-        : Json_object_<KeyT,Json>(std::forward<json_object>(val))
+        : Json_object_<KeyT,Json>(std::forward<json_object>(val)),
+          index_(std::move(val.index_))
     {
     }
 
     json_object(const json_object& val, const allocator_type& allocator) 
-        : Json_object_<KeyT,Json>(val,allocator)
+        : Json_object_<KeyT,Json>(val,allocator),
+          index_(val.index_,index_allocator_type(allocator))
     {
     }
 
     json_object(json_object&& val,const allocator_type& allocator) 
-        : Json_object_<KeyT,Json>(std::forward<json_object>(val),allocator)
+        : Json_object_<KeyT,Json>(std::forward<json_object>(val),allocator),
+          index_(std::move(val.index_),index_allocator_type(allocator))
     {
     }
 
@@ -1323,7 +1371,8 @@ public:
 
     json_object(std::initializer_list<typename Json::array> init, 
                 const allocator_type& allocator)
-        : Json_object_<KeyT,Json>(allocator)
+        : Json_object_<KeyT,Json>(allocator),
+          index_(index_allocator_type(allocator))
     {
         for (const auto& element : init)
         {
@@ -1342,6 +1391,7 @@ public:
     void swap(json_object& val)
     {
         Json_object_<KeyT,Json>::swap(val);
+        index_.swap(val.index_);
     }
 
     iterator begin()
@@ -1368,7 +1418,11 @@ public:
 
     size_t capacity() const {return this->members_.capacity();}
 
-    void clear() {this->members_.clear();}
+    void clear() 
+    {
+        this->members_.clear();
+        index_.clear();
+    }
 
     void shrink_to_fit() 
     {
@@ -1401,28 +1455,27 @@ public:
 
     iterator find(const string_view_type& name)
     {
-        return std::find_if(this->members_.begin(),this->members_.end(), 
-                            [name](const value_type& kv){return kv.key() == name;});
+        return this->members_.begin() + find_position(name);
     }
 
     const_iterator find(const string_view_type& name) const
     {
-        return std::find_if(this->members_.begin(),this->members_.end(), 
-                            [name](const value_type& kv){return kv.key() == name;});
+        return this->members_.begin() + find_position(name);
     }
 
     void erase(const_iterator first, const_iterator last) 
     {
         this->members_.erase(first,last);
+        reindex();
     }
 
     void erase(const string_view_type& name) 
     {
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                              [name](const value_type& kv){return kv.key() == name;});
+        auto it = find(name);
         if (it != this->members_.end())
         {
             this->members_.erase(it);
+            reindex();
         }
     }
 
@@ -1435,9 +1488,34 @@ public:
         {
             this->members_.emplace_back(pred(*s));
         }
+        normalize();
+    }
+
+    // Removes members with duplicate names, keeping the last of each
+    void normalize()
+    {
+        // Small objects are checked for duplicates in place, without the allocations of last_wins_unique_sequence
+        const size_t n = this->members_.size();
+        if (n <= 16)
+        {
+            bool has_duplicates = false;
+            for (size_t i = 1; !has_duplicates && i < n; ++i)
+            {
+                for (size_t j = 0; !has_duplicates && j < i; ++j)
+                {
+                    has_duplicates = this->members_[i].key() == this->members_[j].key();
+                }
+            }
+            if (!has_duplicates)
+            {
+                reindex();
+                return;
+            }
+        }
         auto it = last_wins_unique_sequence(this->members_.begin(), this->members_.end(),
                               [](const value_type& a, const value_type& b){ return a.key().compare(b.key());});
         this->members_.erase(it,this->members_.end());
+        reindex();
     }
 
     // insert_or_assign
@@ -1447,14 +1525,14 @@ public:
     insert_or_assign(const string_view_type& name, T&& value)
     {
         bool inserted;
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [name](const value_type& a){return a.key() == name;});
+        auto it = find(name);
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
                                         std::forward<T>(value));
             it = this->members_.begin() + this->members_.size() - 1;
+            index_back();
             inserted = true;
         }
         else
@@ -1470,14 +1548,14 @@ public:
     insert_or_assign(const string_view_type& name, T&& value)
     {
         bool inserted;
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [name](const value_type& a){return a.key() == name;});
+        auto it = find(name);
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(key_storage_type(name.begin(),name.end(),get_allocator()), 
                                         std::forward<T>(value),get_allocator());
             it = this->members_.begin() + this->members_.size() - 1;
+            index_back();
             inserted = true;
         }
         else
@@ -1500,14 +1578,14 @@ public:
         }
         else
         {
-            it = std::find_if(this->members_.begin(),this->members_.end(), 
-                              [key](const value_type& a){return a.key() == key;});
+            it = find(key);
 
             if (it == this->members_.end())
             {
                 this->members_.emplace_back(key_storage_type(key.begin(),key.end()), 
                                             std::forward<T>(value));
                 it = this->members_.begin() + this->members_.size() - 1;
+                index_back();
             }
             else
             {
@@ -1529,14 +1607,14 @@ public:
         }
         else
         {
-            it = std::find_if(this->members_.begin(),this->members_.end(), 
-                              [key](const value_type& a){return a.key() == key;});
+            it = find(key);
 
             if (it == this->members_.end())
             {
                 this->members_.emplace_back(key_storage_type(key.begin(),key.end(),get_allocator()), 
                                             std::forward<T>(value),get_allocator());
                 it = this->members_.begin() + this->members_.size() - 1;
+                index_back();
             }
             else
             {
@@ -1562,11 +1640,11 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            auto pos = std::find_if(this->members_.begin(),this->members_.end(), 
-                                    [it](const value_type& a){return a.key() == it->key();});
+            auto pos = find(it->key());
             if (pos == this->members_.end() )
             {
                 this->members_.emplace_back(*it);
+                index_back();
             }
         }
     }
@@ -1585,11 +1663,11 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            auto pos = std::find_if(this->members_.begin(),this->members_.end(), 
-                                    [it](const value_type& a){return a.key() == it->key();});
+            auto pos = find(it->key());
             if (pos == this->members_.end() )
             {
                 hint = this->members_.emplace(hint,*it);
+                reindex();
             }
         }
     }
@@ -1610,11 +1688,11 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            auto pos = std::find_if(this->members_.begin(),this->members_.end(), 
-                                    [it](const value_type& a){return a.key() == it->key();});
+            auto pos = find(it->key());
             if (pos == this->members_.end() )
             {
                 this->members_.emplace_back(*it);
+                index_back();
             }
             else
             {
@@ -1637,11 +1715,11 @@ public:
         auto end = std::make_move_iterator(source.end());
         for (; it != end; ++it)
         {
-            auto pos = std::find_if(this->members_.begin(),this->members_.end(), 
-                                    [it](const value_type& a){return a.key() == it->key();});
+            auto pos = find(it->key());
             if (pos == this->members_.end() )
             {
                 hint = this->members_.emplace(hint,*it);
+                reindex();
             }
             else
             {
@@ -1657,14 +1735,14 @@ public:
     try_emplace(const string_view_type& key, Args&&... args)
     {
         bool inserted;
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [key](const value_type& a){return a.key() == key;});
+        auto it = find(key);
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(key_storage_type(key.begin(),key.end()), 
                                         std::forward<Args>(args)...);
             it = this->members_.begin() + this->members_.size() - 1;
+            index_back();
             inserted = true;
 
         }
@@ -1680,14 +1758,14 @@ public:
     try_emplace(const string_view_type& key, Args&&... args)
     {
         bool inserted;
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [key](const value_type& a){return a.key() == key;});
+        auto it = find(key);
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(key_storage_type(key.begin(),key.end(), get_allocator()), 
                                         std::forward<Args>(args)...);
             it = this->members_.begin() + this->members_.size() - 1;
+            index_back();
             inserted = true;
 
         }
@@ -1702,8 +1780,7 @@ public:
     typename std::enable_if<is_stateless<A>::value,iterator>::type
     try_emplace(iterator hint, const string_view_type& key, Args&&... args)
     {
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [key](const value_type& a){return a.key() == key;});
+        auto it = find(key);
 
         if (it == this->members_.end())
         {
@@ -1712,12 +1789,14 @@ public:
                 this->members_.emplace_back(key_storage_type(key.begin(),key.end()), 
                                             std::forward<Args>(args)...);
                 it = this->members_.begin() + (this->members_.size() - 1);
+                index_back();
             }
             else
             {
                 it = this->members_.emplace(hint, 
                                             key_storage_type(key.begin(),key.end()), 
                                             std::forward<Args>(args)...);
+                reindex();
             }
         }
         return it;
@@ -1727,8 +1806,7 @@ public:
     typename std::enable_if<!is_stateless<A>::value,iterator>::type
     try_emplace(iterator hint, const string_view_type& key, Args&&... args)
     {
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [key](const value_type& a){return a.key() == key;});
+        auto it = find(key);
 
         if (it == this->members_.end())
         {
@@ -1737,12 +1815,14 @@ public:
                 this->members_.emplace_back(key_storage_type(key.begin(),key.end(), get_allocator()), 
                                             std::forward<Args>(args)...);
                 it = this->members_.begin() + (this->members_.size() - 1);
+                index_back();
             }
             else
             {
                 it = this->members_.emplace(hint, 
                                             key_storage_type(key.begin(),key.end(), get_allocator()), 
                                             std::forward<Args>(args)...);
+                reindex();
             }
         }
         return it;
@@ -1754,14 +1834,13 @@ public:
     typename std::enable_if<is_stateless<A>::value,void>::type 
     set_(key_storage_type&& key, T&& value)
     {
-        string_view_type s(key.data(),key.size());
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [s](const value_type& a){return a.key().compare(s) == 0;});
+        auto it = find(string_view_type(key.data(),key.size()));
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(std::forward<key_storage_type>(key), 
                                   std::forward<T>(value));
+            index_back();
         }
         else
         {
@@ -1773,14 +1852,13 @@ public:
     typename std::enable_if<!is_stateless<A>::value,void>::type 
     set_(key_storage_type&& key, T&& value)
     {
-        string_view_type s(key.data(),key.size());
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [s](const value_type& a){return a.key().compare(s) == 0;});
+        auto it = find(string_view_type(key.data(),key.size()));
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(std::forward<key_storage_type>(key), 
                                   std::forward<T>(value),get_allocator());
+            index_back();
         }
         else
         {
@@ -1799,6 +1877,7 @@ public:
             this->members_.emplace_back(std::forward<key_storage_type>(key), 
                                   std::forward<T>(value));
             it = this->members_.begin() + (this->members_.size() - 1);
+            index_back();
         }
         else if (it->key() == key)
         {
@@ -1809,6 +1888,7 @@ public:
             it = this->members_.emplace(it,
                                   std::forward<key_storage_type>(key),
                                   std::forward<T>(value));
+            reindex();
         }
         return it;
     }
@@ -1824,6 +1904,7 @@ public:
             this->members_.emplace_back(std::forward<key_storage_type>(key), 
                                   std::forward<T>(value), get_allocator());
             it = this->members_.begin() + (this->members_.size() - 1);
+            index_back();
         }
         else if (it->key() == key)
         {
@@ -1834,6 +1915,7 @@ public:
             it = this->members_.emplace(it,
                                   std::forward<key_storage_type>(key),
                                   std::forward<T>(value), get_allocator());
+            reindex();
         }
         return it;
     }
@@ -1846,8 +1928,7 @@ public:
         }
         for (auto it = this->members_.begin(); it != this->members_.end(); ++it)
         {
-            auto rhs_it = std::find_if(rhs.begin(),rhs.end(), 
-                                       [it](const value_type& a){return a.key() == it->key();});
+            auto rhs_it = rhs.find(it->key());
             if (rhs_it == rhs.end() || rhs_it->key() != it->key() || rhs_it->value() != it->value())
             {
                 return false;
@@ -1857,6 +1938,82 @@ public:
     }
 private:
     json_object& operator=(const json_object&) = delete;
+
+    // Returns the position of the member with the given name, or size() if there is none
+    size_t find_position(const string_view_type& name) const
+    {
+        const size_t n = this->members_.size();
+        if (index_.empty())
+        {
+            size_t pos = 0;
+            while (pos < n && this->members_[pos].key() != name)
+            {
+                ++pos;
+            }
+            return pos;
+        }
+        const size_t mask = index_.size() - 1;
+        for (size_t i = detail::hash_chars(name.data(),name.size()) & mask; index_[i] != 0; i = (i + 1) & mask)
+        {
+            size_t pos = index_[i] - 1;
+            if (this->members_[pos].key() == name)
+            {
+                return pos;
+            }
+        }
+        return n;
+    }
+
+    void build_index()
+    {
+        size_t length = 2*index_threshold;
+        while (length < 2*this->members_.size())
+        {
+            length *= 2;
+        }
+        index_.assign(length, 0);
+        for (size_t pos = 0; pos < this->members_.size(); ++pos)
+        {
+            index_position(pos);
+        }
+    }
+
+    void index_position(size_t pos)
+    {
+        const size_t mask = index_.size() - 1;
+        const string_view_type name = this->members_[pos].key();
+        size_t i = detail::hash_chars(name.data(),name.size()) & mask;
+        while (index_[i] != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        index_[i] = pos + 1;
+    }
+
+    void reindex()
+    {
+        if (this->members_.size() >= index_threshold)
+        {
+            build_index();
+        }
+        else
+        {
+            index_.clear();
+        }
+    }
+
+    // Adds the member just appended, keeping the index at most half full
+    void index_back()
+    {
+        if (index_.empty() || 2*this->members_.size() > index_.size())
+        {
+            reindex();
+        }
+        else
+        {
+            index_position(this->members_.size() - 1);
+        }
+    }
 };
 
 }
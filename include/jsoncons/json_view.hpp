@@ -0,0 +1,1101 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_VIEW_HPP
+#define JSONCONS_JSON_VIEW_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_input_handler.hpp>
+#include <jsoncons/json_output_handler.hpp>
+#include <jsoncons/json_filter.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_index_parser.hpp>
+
+namespace jsoncons {
+
+template <class CharT, class Allocator>
+class basic_json_tape;
+
+template <class CharT, class Allocator>
+class basic_json_view;
+
+template <class CharT, class Allocator>
+class basic_json_tape_builder;
+
+namespace detail {
+
+enum class tape_tag : uint8_t
+{
+    null_t,
+    bool_t,
+    integer_t,
+    uinteger_t,
+    double_t,
+    string_t,
+    byte_string_t,
+    name_t,
+    array_t,
+    object_t
+};
+
+// tape_entry
+// One value of a document in a basic_json_tape. Arrays and objects are followed by their
+// elements, an object member by an entry for its name and then its value. A container records
+// the position just past its last descendant, so the next sibling of any value is one step away.
+
+struct tape_entry
+{
+    tape_tag tag_;
+    uint8_t precision_;
+    uint8_t decimal_places_;
+    size_t length_;  // characters or bytes of a string, elements or members of a container
+    union
+    {
+        bool bool_val_;
+        int64_t int_val_;
+        uint64_t uint_val_;
+        double double_val_;
+        size_t offset_; // of a string in the string or byte buffer
+        size_t end_;    // of a container, the position after its last descendant
+    };
+
+    tape_entry(tape_tag tag)
+        : tag_(tag), precision_(0), decimal_places_(0), length_(0), uint_val_(0)
+    {
+    }
+
+    bool is_container() const
+    {
+        return tag_ == tape_tag::array_t || tag_ == tape_tag::object_t;
+    }
+};
+
+template <class View>
+class tape_array_iterator
+{
+    typedef typename View::tape_type tape_type;
+
+    const tape_type* tape_;
+    size_t pos_;
+public:
+    typedef View value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const View* pointer;
+    typedef View reference;
+    typedef std::forward_iterator_tag iterator_category;
+
+    tape_array_iterator()
+        : tape_(nullptr), pos_(0)
+    {
+    }
+
+    tape_array_iterator(const tape_type* tape, size_t pos)
+        : tape_(tape), pos_(pos)
+    {
+    }
+
+    reference operator*() const
+    {
+        return View(tape_, pos_);
+    }
+
+    tape_array_iterator& operator++()
+    {
+        pos_ = tape_->next(pos_);
+        return *this;
+    }
+
+    tape_array_iterator operator++(int)
+    {
+        tape_array_iterator temp(*this);
+        ++(*this);
+        return temp;
+    }
+
+    friend bool operator==(const tape_array_iterator& lhs, const tape_array_iterator& rhs)
+    {
+        return lhs.pos_ == rhs.pos_;
+    }
+
+    friend bool operator!=(const tape_array_iterator& lhs, const tape_array_iterator& rhs)
+    {
+        return lhs.pos_ != rhs.pos_;
+    }
+};
+
+template <class View>
+class tape_key_value_pair
+{
+    typedef typename View::tape_type tape_type;
+    typedef typename View::string_view_type string_view_type;
+
+    const tape_type* tape_;
+    size_t pos_;
+public:
+    tape_key_value_pair()
+        : tape_(nullptr), pos_(0)
+    {
+    }
+
+    tape_key_value_pair(const tape_type* tape, size_t pos)
+        : tape_(tape), pos_(pos)
+    {
+    }
+
+    string_view_type key() const
+    {
+        return tape_->string_at(pos_);
+    }
+
+    View value() const
+    {
+        return View(tape_, pos_ + 1);
+    }
+};
+
+template <class View>
+class tape_object_iterator
+{
+    typedef typename View::tape_type tape_type;
+
+    const tape_type* tape_;
+    size_t pos_;
+    tape_key_value_pair<View> member_;
+public:
+    typedef tape_key_value_pair<View> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const tape_key_value_pair<View>* pointer;
+    typedef const tape_key_value_pair<View>& reference;
+    typedef std::forward_iterator_tag iterator_category;
+
+    tape_object_iterator()
+        : tape_(nullptr), pos_(0)
+    {
+    }
+
+    tape_object_iterator(const tape_type* tape, size_t pos)
+        : tape_(tape), pos_(pos), member_(tape, pos)
+    {
+    }
+
+    reference operator*() const
+    {
+        return member_;
+    }
+
+    pointer operator->() const
+    {
+        return &member_;
+    }
+
+    tape_object_iterator& operator++()
+    {
+        pos_ = tape_->next(pos_ + 1);
+        member_ = tape_key_value_pair<View>(tape_, pos_);
+        return *this;
+    }
+
+    tape_object_iterator operator++(int)
+    {
+        tape_object_iterator temp(*this);
+        ++(*this);
+        return temp;
+    }
+
+    friend bool operator==(const tape_object_iterator& lhs, const tape_object_iterator& rhs)
+    {
+        return lhs.pos_ == rhs.pos_;
+    }
+
+    friend bool operator!=(const tape_object_iterator& lhs, const tape_object_iterator& rhs)
+    {
+        return lhs.pos_ != rhs.pos_;
+    }
+};
+
+}
+
+// basic_json_tape
+// An immutable document stored as one contiguous array of tape entries, with the characters
+// of every name and string in a single buffer. It is built directly from parser events, and
+// read through basic_json_view, which is a position on the tape.
+
+template <class CharT, class Allocator = std::allocator<char>>
+class basic_json_tape
+{
+public:
+    typedef CharT char_type;
+    typedef std::char_traits<CharT> char_traits_type;
+    typedef Allocator allocator_type;
+    typedef basic_string_view_ext<CharT,char_traits_type> string_view_type;
+    typedef basic_json_view<CharT,Allocator> view_type;
+
+    friend class basic_json_view<CharT,Allocator>;
+    friend class basic_json_tape_builder<CharT,Allocator>;
+    friend class detail::tape_array_iterator<view_type>;
+    friend class detail::tape_object_iterator<view_type>;
+    friend class detail::tape_key_value_pair<view_type>;
+private:
+    typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<detail::tape_entry> entry_allocator_type;
+    typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<CharT> char_allocator_type;
+    typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<uint8_t> byte_allocator_type;
+
+    std::vector<detail::tape_entry,entry_allocator_type> entries_;
+    std::vector<CharT,char_allocator_type> chars_;
+    std::vector<uint8_t,byte_allocator_type> bytes_;
+
+    size_t next(size_t pos) const
+    {
+        const detail::tape_entry& e = entries_[pos];
+        return e.is_container() ? e.end_ : pos + 1;
+    }
+
+    string_view_type string_at(size_t pos) const
+    {
+        const detail::tape_entry& e = entries_[pos];
+        return string_view_type(chars_.data() + e.offset_, e.length_);
+    }
+public:
+    basic_json_tape()
+    {
+    }
+
+    explicit basic_json_tape(const allocator_type& allocator)
+        : entries_(entry_allocator_type(allocator)),
+          chars_(char_allocator_type(allocator)),
+          bytes_(byte_allocator_type(allocator))
+    {
+    }
+
+    basic_json_tape(const basic_json_tape&) = default;
+
+    basic_json_tape(basic_json_tape&& other) JSONCONS_NOEXCEPT
+        : entries_(std::move(other.entries_)),
+          chars_(std::move(other.chars_)),
+          bytes_(std::move(other.bytes_))
+    {
+    }
+
+    basic_json_tape& operator=(const basic_json_tape&) = default;
+
+    basic_json_tape& operator=(basic_json_tape&& other) JSONCONS_NOEXCEPT
+    {
+        entries_.swap(other.entries_);
+        chars_.swap(other.chars_);
+        bytes_.swap(other.bytes_);
+        return *this;
+    }
+
+    // The document, or a null value if the tape is empty
+    view_type root() const
+    {
+        return view_type(this, 0);
+    }
+
+    bool empty() const
+    {
+        return entries_.empty();
+    }
+
+    // The number of entries on the tape
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+    void clear()
+    {
+        entries_.clear();
+        chars_.clear();
+        bytes_.clear();
+    }
+
+    void shrink_to_fit()
+    {
+        entries_.shrink_to_fit();
+        chars_.shrink_to_fit();
+        bytes_.shrink_to_fit();
+    }
+
+    static basic_json_tape parse(const string_view_type& s)
+    {
+        auto result = unicons::skip_bom(s.begin(), s.end());
+        if (result.ec != unicons::encoding_errc())
+        {
+            throw parse_error(result.ec,1,1);
+        }
+        size_t offset = result.it - s.begin();
+
+        // As in basic_json::parse, strict JSON goes through the structural index parser first
+        {
+            basic_json_tape_builder<CharT,Allocator> builder;
+            basic_json_index_parser<char_type> parser(builder);
+            std::error_code ec;
+            parser.parse(s.data()+offset,s.size()-offset,ec);
+            if (!ec && builder.is_valid())
+            {
+                return builder.get_result();
+            }
+        }
+
+        basic_json_tape_builder<CharT,Allocator> builder;
+        basic_json_parser<char_type> parser(builder);
+        parser.set_source(s.data()+offset,s.size()-offset);
+        parser.parse_some();
+        parser.end_parse();
+        parser.check_done();
+        if (!builder.is_valid())
+        {
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Failed to parse json string"));
+        }
+        return builder.get_result();
+    }
+
+    static basic_json_tape parse(std::basic_istream<char_type>& is)
+    {
+        basic_json_tape_builder<CharT,Allocator> builder;
+        basic_json_reader<char_type> reader(is, builder);
+        reader.read_next();
+        reader.check_done();
+        if (!builder.is_valid())
+        {
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Failed to parse json stream"));
+        }
+        return builder.get_result();
+    }
+};
+
+// basic_json_tape_builder
+// An input handler that appends parser events to a basic_json_tape.
+
+template <class CharT, class Allocator = std::allocator<char>>
+class basic_json_tape_builder : public basic_json_input_handler<CharT>
+{
+public:
+    using typename basic_json_input_handler<CharT>::string_view_type;
+    typedef basic_json_tape<CharT,Allocator> tape_type;
+private:
+    typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<size_t> size_t_allocator_type;
+
+    tape_type tape_;
+    std::vector<size_t,size_t_allocator_type> structure_stack_;
+    bool is_valid_;
+
+    void add_value(const detail::tape_entry& e)
+    {
+        if (!structure_stack_.empty())
+        {
+            detail::tape_entry& parent = tape_.entries_[structure_stack_.back()];
+            if (parent.tag_ == detail::tape_tag::array_t)
+            {
+                ++parent.length_;
+            }
+        }
+        tape_.entries_.push_back(e);
+    }
+
+    void add_string(detail::tape_tag tag, const string_view_type& s)
+    {
+        detail::tape_entry e(tag);
+        e.offset_ = tape_.chars_.size();
+        e.length_ = s.length();
+        tape_.chars_.insert(tape_.chars_.end(), s.data(), s.data() + s.length());
+        if (tag == detail::tape_tag::name_t)
+        {
+            ++tape_.entries_[structure_stack_.back()].length_;
+            tape_.entries_.push_back(e);
+        }
+        else
+        {
+            add_value(e);
+        }
+    }
+
+    void begin_structure(detail::tape_tag tag)
+    {
+        add_value(detail::tape_entry(tag));
+        structure_stack_.push_back(tape_.entries_.size() - 1);
+    }
+
+    void end_structure()
+    {
+        JSONCONS_ASSERT(!structure_stack_.empty());
+        tape_.entries_[structure_stack_.back()].end_ = tape_.entries_.size();
+        structure_stack_.pop_back();
+    }
+public:
+    basic_json_tape_builder(const Allocator& allocator = Allocator())
+        : tape_(allocator), structure_stack_(size_t_allocator_type(allocator)), is_valid_(false)
+    {
+        structure_stack_.reserve(100);
+    }
+
+    bool is_valid() const
+    {
+        return is_valid_;
+    }
+
+    tape_type get_result()
+    {
+        is_valid_ = false;
+        return std::move(tape_);
+    }
+
+private:
+    void do_begin_json() override
+    {
+        is_valid_ = false;
+        tape_.clear();
+        structure_stack_.clear();
+    }
+
+    void do_end_json() override
+    {
+        if (structure_stack_.empty())
+        {
+            is_valid_ = true;
+        }
+    }
+
+    void do_begin_object(const parsing_context&) override
+    {
+        begin_structure(detail::tape_tag::object_t);
+    }
+
+    void do_end_object(const parsing_context&) override
+    {
+        end_structure();
+    }
+
+    void do_begin_array(const parsing_context&) override
+    {
+        begin_structure(detail::tape_tag::array_t);
+    }
+
+    void do_end_array(const parsing_context&) override
+    {
+        end_structure();
+    }
+
+    void do_name(const string_view_type& name, const parsing_context&) override
+    {
+        add_string(detail::tape_tag::name_t, name);
+    }
+
+    void do_string_value(const string_view_type& val, const parsing_context&) override
+    {
+        add_string(detail::tape_tag::string_t, val);
+    }
+
+    void do_byte_string_value(const uint8_t* data, size_t length, const parsing_context&) override
+    {
+        detail::tape_entry e(detail::tape_tag::byte_string_t);
+        e.offset_ = tape_.bytes_.size();
+        e.length_ = length;
+        tape_.bytes_.insert(tape_.bytes_.end(), data, data + length);
+        add_value(e);
+    }
+
+    void do_integer_value(int64_t value, const parsing_context&) override
+    {
+        detail::tape_entry e(detail::tape_tag::integer_t);
+        e.int_val_ = value;
+        add_value(e);
+    }
+
+    void do_uinteger_value(uint64_t value, const parsing_context&) override
+    {
+        detail::tape_entry e(detail::tape_tag::uinteger_t);
+        e.uint_val_ = value;
+        add_value(e);
+    }
+
+    void do_double_value(double value, const number_format& fmt, const parsing_context&) override
+    {
+        detail::tape_entry e(detail::tape_tag::double_t);
+        e.double_val_ = value;
+        e.precision_ = fmt.precision();
+        e.decimal_places_ = fmt.decimal_places();
+        add_value(e);
+    }
+
+    void do_bool_value(bool value, const parsing_context&) override
+    {
+        detail::tape_entry e(detail::tape_tag::bool_t);
+        e.bool_val_ = value;
+        add_value(e);
+    }
+
+    void do_null_value(const parsing_context&) override
+    {
+        add_value(detail::tape_entry(detail::tape_tag::null_t));
+    }
+};
+
+// basic_json_view
+// A read-only value on a basic_json_tape, valid as long as the tape is. Moving to the next
+// element or member is O(1), at(index) and at(name) are linear in the number of elements or
+// members before the one found, and nothing is allocated unless a string is copied out.
+
+template <class CharT, class Allocator = std::allocator<char>>
+class basic_json_view
+{
+public:
+    typedef CharT char_type;
+    typedef std::char_traits<char_type> char_traits_type;
+    typedef Allocator allocator_type;
+    typedef std::basic_string<char_type,char_traits_type> string_type;
+    typedef basic_string_view_ext<char_type,char_traits_type> string_view_type;
+    typedef basic_json_tape<CharT,Allocator> tape_type;
+
+    typedef std::ptrdiff_t difference_type;
+    typedef basic_json_view value_type;
+    typedef basic_json_view& reference;
+    typedef const basic_json_view& const_reference;
+    typedef basic_json_view* pointer;
+    typedef const basic_json_view* const_pointer;
+
+    typedef detail::tape_key_value_pair<basic_json_view> key_value_pair_type;
+    typedef detail::tape_object_iterator<basic_json_view> object_iterator;
+    typedef detail::tape_object_iterator<basic_json_view> const_object_iterator;
+    typedef detail::tape_array_iterator<basic_json_view> array_iterator;
+    typedef detail::tape_array_iterator<basic_json_view> const_array_iterator;
+
+    // What a view has in place of array and object values
+    typedef range<const_array_iterator> array;
+    typedef range<const_object_iterator> object;
+private:
+    const tape_type* tape_;
+    size_t pos_;
+
+    static const detail::tape_entry& null_entry()
+    {
+        static const detail::tape_entry e(detail::tape_tag::null_t);
+        return e;
+    }
+
+    const detail::tape_entry& entry() const
+    {
+        return tape_ != nullptr && pos_ < tape_->entries_.size() ? tape_->entries_[pos_] : null_entry();
+    }
+
+    detail::tape_tag tag() const
+    {
+        return entry().tag_;
+    }
+public:
+    basic_json_view()
+        : tape_(nullptr), pos_(0)
+    {
+    }
+
+    basic_json_view(const tape_type* tape, size_t pos)
+        : tape_(tape), pos_(pos)
+    {
+    }
+
+    basic_json_view(const basic_json_view&) = default;
+
+    basic_json_view& operator=(const basic_json_view&) = default;
+
+    bool is_null() const
+    {
+        return tag() == detail::tape_tag::null_t;
+    }
+
+    bool is_bool() const
+    {
+        return tag() == detail::tape_tag::bool_t;
+    }
+
+    bool is_integer() const
+    {
+        return tag() == detail::tape_tag::integer_t;
+    }
+
+    bool is_uinteger() const
+    {
+        return tag() == detail::tape_tag::uinteger_t;
+    }
+
+    bool is_double() const
+    {
+        return tag() == detail::tape_tag::double_t;
+    }
+
+    bool is_number() const
+    {
+        return is_integer() || is_uinteger() || is_double();
+    }
+
+    bool is_string() const
+    {
+        return tag() == detail::tape_tag::string_t;
+    }
+
+    bool is_byte_string() const
+    {
+        return tag() == detail::tape_tag::byte_string_t;
+    }
+
+    bool is_array() const
+    {
+        return tag() == detail::tape_tag::array_t;
+    }
+
+    bool is_object() const
+    {
+        return tag() == detail::tape_tag::object_t;
+    }
+
+    template<class T>
+    bool is() const
+    {
+        return json_type_traits<basic_json_view,T>::is(*this);
+    }
+
+    // Elements of an array, members of an object, characters of a string, otherwise 0
+    size_t size() const
+    {
+        switch (tag())
+        {
+        case detail::tape_tag::array_t:
+        case detail::tape_tag::object_t:
+        case detail::tape_tag::string_t:
+        case detail::tape_tag::byte_string_t:
+            return entry().length_;
+        default:
+            return 0;
+        }
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    range<const_array_iterator> array_range() const
+    {
+        if (!is_array())
+        {
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not an array"));
+        }
+        return range<const_array_iterator>(const_array_iterator(tape_, pos_ + 1),
+                                           const_array_iterator(tape_, entry().end_));
+    }
+
+    range<const_object_iterator> object_range() const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not an object"));
+        }
+        return range<const_object_iterator>(const_object_iterator(tape_, pos_ + 1),
+                                            const_object_iterator(tape_, entry().end_));
+    }
+
+    basic_json_view at(size_t index) const
+    {
+        if (!is_array())
+        {
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Index on non-array value not supported"));
+        }
+        if (index >= entry().length_)
+        {
+            JSONCONS_THROW(json_exception_impl<std::out_of_range>("Invalid array subscript"));
+        }
+        size_t pos = pos_ + 1;
+        for (size_t i = 0; i < index; ++i)
+        {
+            pos = tape_->next(pos);
+        }
+        return basic_json_view(tape_, pos);
+    }
+
+    basic_json_view at(const string_view_type& name) const
+    {
+        const_object_iterator it = find(name);
+        if (it == object_range().end())
+        {
+            JSONCONS_THROW(key_not_found(name.data(),name.length()));
+        }
+        return it->value();
+    }
+
+    basic_json_view operator[](size_t index) const
+    {
+        return at(index);
+    }
+
+    basic_json_view operator[](const string_view_type& name) const
+    {
+        return at(name);
+    }
+
+    // The first member named name, or the end of the object range. Members are in document
+    // order, and a name that appears more than once finds the first.
+    const_object_iterator find(const string_view_type& name) const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not an object"));
+        }
+        const size_t end = entry().end_;
+        size_t pos = pos_ + 1;
+        while (pos != end && tape_->string_at(pos) != name)
+        {
+            pos = tape_->next(pos + 1);
+        }
+        return const_object_iterator(tape_, pos);
+    }
+
+    bool has_key(const string_view_type& name) const
+    {
+        return is_object() && find(name) != object_range().end();
+    }
+
+    size_t count(const string_view_type& name) const
+    {
+        size_t n = 0;
+        if (is_object())
+        {
+            for (const auto& member : object_range())
+            {
+                if (member.key() == name)
+                {
+                    ++n;
+                }
+            }
+        }
+        return n;
+    }
+
+    bool as_bool() const
+    {
+        const detail::tape_entry& e = entry();
+        switch (e.tag_)
+        {
+        case detail::tape_tag::bool_t:
+            return e.bool_val_;
+        case detail::tape_tag::integer_t:
+            return e.int_val_ != 0;
+        case detail::tape_tag::uinteger_t:
+            return e.uint_val_ != 0;
+        default:
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a bool"));
+        }
+    }
+
+    int64_t as_integer() const
+    {
+        const detail::tape_entry& e = entry();
+        switch (e.tag_)
+        {
+        case detail::tape_tag::integer_t:
+            return e.int_val_;
+        case detail::tape_tag::uinteger_t:
+            return static_cast<int64_t>(e.uint_val_);
+        case detail::tape_tag::double_t:
+            return static_cast<int64_t>(e.double_val_);
+        case detail::tape_tag::bool_t:
+            return e.bool_val_ ? 1 : 0;
+        default:
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not an integer"));
+        }
+    }
+
+    uint64_t as_uinteger() const
+    {
+        const detail::tape_entry& e = entry();
+        switch (e.tag_)
+        {
+        case detail::tape_tag::integer_t:
+            return static_cast<uint64_t>(e.int_val_);
+        case detail::tape_tag::uinteger_t:
+            return e.uint_val_;
+        case detail::tape_tag::double_t:
+            return static_cast<uint64_t>(e.double_val_);
+        case detail::tape_tag::bool_t:
+            return e.bool_val_ ? 1 : 0;
+        default:
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not an unsigned integer"));
+        }
+    }
+
+    double as_double() const
+    {
+        const detail::tape_entry& e = entry();
+        switch (e.tag_)
+        {
+        case detail::tape_tag::double_t:
+            return e.double_val_;
+        case detail::tape_tag::integer_t:
+            return static_cast<double>(e.int_val_);
+        case detail::tape_tag::uinteger_t:
+            return static_cast<double>(e.uint_val_);
+        default:
+            JSONCONS_THROW(json_exception_impl<std::invalid_argument>("Not a double"));
+        }
+    }
+
+    // The characters of a string, in the tape's buffer
+    string_view_type as_string_view() const
+    {
+        if (!is_string())
+        {
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a string"));
+        }
+        return tape_->string_at(pos_);
+    }
+
+    byte_string_view as_byte_string_view() const
+    {
+        if (!is_byte_string())
+        {
+            JSONCONS_THROW(json_exception_impl<std::runtime_error>("Not a byte string"));
+        }
+        const detail::tape_entry& e = entry();
+        return byte_string_view(tape_->bytes_.data() + e.offset_, e.length_);
+    }
+
+    // A string's characters, or any other value serialized as JSON
+    string_type as_string() const
+    {
+        return as_string(std::allocator<char_type>());
+    }
+
+    template <class SAllocator>
+    std::basic_string<char_type,char_traits_type,SAllocator> as_string(const SAllocator& allocator) const
+    {
+        typedef std::basic_string<char_type,char_traits_type,SAllocator> result_type;
+        if (is_string())
+        {
+            string_view_type s = as_string_view();
+            return result_type(s.data(), s.length(), allocator);
+        }
+        result_type s(allocator);
+        dump(s);
+        return s;
+    }
+
+    template <class T>
+    T as() const
+    {
+        return json_type_traits<basic_json_view,T>::as(*this);
+    }
+
+    // Replays the value as events, without recursion
+    void dump(basic_json_output_handler<char_type>& handler) const
+    {
+        handler.begin_json();
+        dump_fragment(handler);
+        handler.end_json();
+    }
+
+    void dump_fragment(basic_json_output_handler<char_type>& handler) const
+    {
+        if (tape_ == nullptr || pos_ >= tape_->entries_.size())
+        {
+            handler.null_value();
+            return;
+        }
+        // Positions where the open containers end, and whether each is an object
+        std::vector<std::pair<size_t,bool>> ends;
+        const size_t last = tape_->next(pos_);
+        for (size_t pos = pos_; pos < last; ++pos)
+        {
+            const detail::tape_entry& e = tape_->entries_[pos];
+            switch (e.tag_)
+            {
+            case detail::tape_tag::null_t:
+                handler.null_value();
+                break;
+            case detail::tape_tag::bool_t:
+                handler.bool_value(e.bool_val_);
+                break;
+            case detail::tape_tag::integer_t:
+                handler.integer_value(e.int_val_);
+                break;
+            case detail::tape_tag::uinteger_t:
+                handler.uinteger_value(e.uint_val_);
+                break;
+            case detail::tape_tag::double_t:
+                handler.double_value(e.double_val_, number_format(e.precision_, e.decimal_places_));
+                break;
+            case detail::tape_tag::string_t:
+                handler.string_value(tape_->string_at(pos));
+                break;
+            case detail::tape_tag::byte_string_t:
+                handler.byte_string_value(tape_->bytes_.data() + e.offset_, e.length_);
+                break;
+            case detail::tape_tag::name_t:
+                handler.name(tape_->string_at(pos));
+                break;
+            case detail::tape_tag::array_t:
+                handler.begin_array(e.length_);
+                ends.push_back(std::make_pair(e.end_, false));
+                break;
+            case detail::tape_tag::object_t:
+                handler.begin_object(e.length_);
+                ends.push_back(std::make_pair(e.end_, true));
+                break;
+            }
+            while (!ends.empty() && ends.back().first == pos + 1)
+            {
+                if (ends.back().second)
+                {
+                    handler.end_object();
+                }
+                else
+                {
+                    handler.end_array();
+                }
+                ends.pop_back();
+            }
+        }
+    }
+
+    template <class SAllocator>
+    void dump(std::basic_string<char_type,char_traits_type,SAllocator>& s) const
+    {
+        basic_json_serializer<char_type,detail::string_writer<char_type>> serializer(s);
+        dump(serializer);
+    }
+
+    void dump(std::basic_ostream<char_type>& os) const
+    {
+        basic_json_serializer<char_type> serializer(os);
+        dump(serializer);
+    }
+
+    void dump(std::basic_ostream<char_type>& os, const basic_serialization_options<char_type>& options) const
+    {
+        basic_json_serializer<char_type> serializer(os, options);
+        dump(serializer);
+    }
+
+    string_type to_string() const
+    {
+        string_type s;
+        dump(s);
+        return s;
+    }
+
+    // Structural equality. Object members are matched by name, regardless of order.
+    friend bool operator==(const basic_json_view& lhs, const basic_json_view& rhs)
+    {
+        if (lhs.tape_ == rhs.tape_ && lhs.pos_ == rhs.pos_)
+        {
+            return true;
+        }
+        switch (lhs.tag())
+        {
+        case detail::tape_tag::array_t:
+            {
+                if (!rhs.is_array() || lhs.size() != rhs.size())
+                {
+                    return false;
+                }
+                auto it = rhs.array_range().begin();
+                for (const auto& element : lhs.array_range())
+                {
+                    if (!(element == *it))
+                    {
+                        return false;
+                    }
+                    ++it;
+                }
+                return true;
+            }
+        case detail::tape_tag::object_t:
+            {
+                if (!rhs.is_object() || lhs.size() != rhs.size())
+                {
+                    return false;
+                }
+                for (const auto& member : lhs.object_range())
+                {
+                    auto it = rhs.find(member.key());
+                    if (it == rhs.object_range().end() || !(member.value() == it->value()))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        case detail::tape_tag::string_t:
+            return rhs.is_string() && lhs.as_string_view() == rhs.as_string_view();
+        case detail::tape_tag::byte_string_t:
+            return rhs.is_byte_string() && lhs.as_byte_string_view() == rhs.as_byte_string_view();
+        case detail::tape_tag::bool_t:
+            return rhs.is_bool() && lhs.as_bool() == rhs.as_bool();
+        case detail::tape_tag::null_t:
+            return rhs.is_null();
+        case detail::tape_tag::double_t:
+            return rhs.is_number() && lhs.as_double() == rhs.as_double();
+        case detail::tape_tag::integer_t:
+            return rhs.is_uinteger() ? lhs.entry().int_val_ >= 0 && lhs.as_uinteger() == rhs.as_uinteger()
+                 : rhs.is_number() && (rhs.is_double() ? lhs.as_double() == rhs.as_double() : lhs.as_integer() == rhs.as_integer());
+        case detail::tape_tag::uinteger_t:
+            return rhs.is_integer() ? rhs == lhs
+                 : rhs.is_number() && (rhs.is_double() ? lhs.as_double() == rhs.as_double() : lhs.as_uinteger() == rhs.as_uinteger());
+        default:
+            return false;
+        }
+    }
+
+    friend bool operator!=(const basic_json_view& lhs, const basic_json_view& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend std::basic_ostream<char_type>& operator<<(std::basic_ostream<char_type>& os, const basic_json_view& v)
+    {
+        v.dump(os);
+        return os;
+    }
+};
+
+typedef basic_json_tape<char> json_tape;
+typedef basic_json_tape<wchar_t> wjson_tape;
+typedef basic_json_view<char> json_view;
+typedef basic_json_view<wchar_t> wjson_view;
+
+// Copies a view into a basic_json
+
+template<class CharT, class Allocator, class ImplementationPolicy, class JsonAllocator>
+struct json_type_traits<basic_json_view<CharT,Allocator>, basic_json<CharT,ImplementationPolicy,JsonAllocator>>
+{
+    typedef basic_json<CharT,ImplementationPolicy,JsonAllocator> json_type;
+
+    static bool is(const basic_json_view<CharT,Allocator>&) JSONCONS_NOEXCEPT
+    {
+        return true;
+    }
+
+    static json_type as(const basic_json_view<CharT,Allocator>& v)
+    {
+        json_decoder<json_type> decoder;
+        basic_json_input_output_adapter<CharT> adapter(decoder);
+        v.dump(adapter);
+        return decoder.get_result();
+    }
+};
+
+}
+
+#endif
@@ -96,6 +96,24 @@ namespace jsoncons
 #define JSONCONS_ALIGNOF alignof
 #endif
 
+// Define JSONCONS_NO_SIMD to disable the SSE2/AVX2 scanning paths and use the portable scalar ones
+#if !defined(JSONCONS_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSONCONS_HAS_SSE2
+#endif
+#if defined(__AVX2__)
+#define JSONCONS_HAS_AVX2
+#endif
+// Without -mavx2, GCC and clang on x86 can still compile AVX2 scanners and select them at run time
+#if defined(JSONCONS_HAS_SSE2) && !defined(JSONCONS_HAS_AVX2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define JSONCONS_HAS_AVX2_DISPATCH
+#endif
+#endif
+
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#define JSONCONS_HAS_POSIX_MMAP
+#endif
+
 #define JSONCONS_DEFINE_LITERAL( name, lit ) \
 template< class Ch > Ch const* name(); \
 template<> inline char const * name<char>() { return lit; } \
@@ -180,6 +180,10 @@ public:
 
     int compare(Basic_string_view_ s) const 
     {
+        if (data_ == s.data_ && length_ == s.length_)
+        {
+            return 0;
+        }
         const int rc = Traits::compare(data_, s.data_, (std::min)(length_, s.length_));
         return rc != 0 ? rc : (length_ == s.length_ ? 0 : length_ < s.length_ ? -1 : 1);
     }
@@ -949,6 +953,23 @@ std::string decode_base64(const std::string& base64_string)
     return result;
 }
 
+namespace detail {
+
+// FNV-1a
+template <class CharT>
+size_t hash_chars(const CharT* s, size_t length)
+{
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i)
+    {
+        h ^= static_cast<uint64_t>(s[i]);
+        h *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(h ^ (h >> 32));
+}
+
+}
+
 }
 
 #endif
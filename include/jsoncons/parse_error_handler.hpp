@@ -99,9 +99,22 @@ public:
         return do_column_number();
     }
 
+    // Called from a name, begin_object or begin_array event, asks the parser to skip the
+    // member's value, or the contents of the object or array, without reporting events.
+    // Returns false if the parser does not support skipping.
+    bool skip_value() const
+    {
+        return do_skip_value();
+    }
+
 private:
     virtual size_t do_line_number() const = 0;
     virtual size_t do_column_number() const = 0;
+
+    virtual bool do_skip_value() const
+    {
+        return false;
+    }
 };
 
 class parse_error_handler
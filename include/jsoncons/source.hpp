@@ -0,0 +1,286 @@
+// Copyright 2018 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_SOURCE_HPP
+#define JSONCONS_SOURCE_HPP
+
+#include <cstddef>
+#include <string>
+#include <istream>
+#include <ios>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/jsoncons_utilities.hpp>
+#if defined(JSONCONS_HAS_POSIX_MMAP)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace jsoncons {
+
+// Sources supply the input of basic_json_reader and basic_csv_reader. A source provides
+//
+//     bool eof() const
+//     bool is_error() const
+//     size_t read_buffer(CharT* buffer, size_t length, const CharT*& data)
+//
+// read_buffer makes the next chunk of input available in [data, data+n) and returns n.
+// Sources that copy their input read at most length characters into buffer and point
+// data at it, sources that hold their input in memory point data into it instead.
+// A chunk must remain valid until the next call to read_buffer.
+
+// stream_source
+
+template <class CharT>
+class stream_source
+{
+    std::basic_istream<CharT>* is_;
+public:
+    typedef CharT char_type;
+
+    stream_source(std::basic_istream<CharT>& is)
+        : is_(std::addressof(is))
+    {
+    }
+
+    bool eof() const
+    {
+        return is_->eof();
+    }
+
+    bool is_error() const
+    {
+        return is_->bad() || (is_->fail() && !is_->eof());
+    }
+
+    size_t read_buffer(CharT* buffer, size_t length, const CharT*& data)
+    {
+        is_->read(buffer, length);
+        data = buffer;
+        return static_cast<size_t>(is_->gcount());
+    }
+};
+
+// string_source
+// Borrows text held in memory and hands it to the reader as a single chunk. The text
+// must outlive the reader.
+
+template <class CharT>
+class string_source
+{
+    const CharT* data_;
+    size_t length_;
+    bool eof_;
+public:
+    typedef CharT char_type;
+    typedef basic_string_view_ext<CharT> string_view_type;
+
+    string_source(const string_view_type& s)
+        : data_(s.data()), length_(s.length()), eof_(false)
+    {
+    }
+
+    string_source(const CharT* data, size_t length)
+        : data_(data), length_(length), eof_(false)
+    {
+    }
+
+    bool eof() const
+    {
+        return eof_;
+    }
+
+    bool is_error() const
+    {
+        return false;
+    }
+
+    size_t read_buffer(CharT*, size_t, const CharT*& data)
+    {
+        if (eof_)
+        {
+            return 0;
+        }
+        eof_ = true;
+        data = data_;
+        return length_;
+    }
+};
+
+#if defined(JSONCONS_HAS_POSIX_MMAP)
+
+// fd_source
+// Reads from a POSIX file descriptor with read(2), retrying reads interrupted by a signal.
+// The descriptor is not closed by the source.
+
+template <class CharT>
+class fd_source
+{
+    int fd_;
+    bool eof_;
+    bool error_;
+public:
+    typedef CharT char_type;
+
+    fd_source(int fd)
+        : fd_(fd), eof_(false), error_(fd < 0)
+    {
+    }
+
+    bool eof() const
+    {
+        return eof_;
+    }
+
+    bool is_error() const
+    {
+        return error_;
+    }
+
+    size_t read_buffer(CharT* buffer, size_t length, const CharT*& data)
+    {
+        data = buffer;
+        if (eof_ || error_)
+        {
+            return 0;
+        }
+        size_t count = 0;
+        size_t size = length*sizeof(CharT);
+        char* p = reinterpret_cast<char*>(buffer);
+        while (count < size)
+        {
+            ssize_t n = ::read(fd_, p + count, size - count);
+            if (n > 0)
+            {
+                count += static_cast<size_t>(n);
+            }
+            else if (n == 0)
+            {
+                eof_ = true;
+                break;
+            }
+            else if (errno != EINTR)
+            {
+                error_ = true;
+                break;
+            }
+        }
+        return count/sizeof(CharT);
+    }
+};
+
+// mmap_source
+// Maps a whole file into memory and hands it to the reader as a single chunk, so the
+// input is neither copied into a buffer nor read through std::istream. The mapping is
+// advised for sequential access.
+
+template <class CharT>
+class mmap_source
+{
+    void* addr_;
+    size_t mapped_length_;
+    const CharT* data_;
+    size_t length_;
+    bool eof_;
+    bool error_;
+
+    // Noncopyable
+    mmap_source(const mmap_source&) = delete;
+    mmap_source& operator=(const mmap_source&) = delete;
+public:
+    typedef CharT char_type;
+
+    mmap_source(const std::string& path)
+        : addr_(MAP_FAILED), mapped_length_(0), data_(nullptr), length_(0), eof_(false), error_(false)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            error_ = true;
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == -1)
+        {
+            error_ = true;
+            ::close(fd);
+            return;
+        }
+        mapped_length_ = static_cast<size_t>(st.st_size);
+        if (mapped_length_ > 0)
+        {
+            addr_ = ::mmap(nullptr, mapped_length_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr_ == MAP_FAILED)
+            {
+                error_ = true;
+            }
+            else
+            {
+#if defined(MADV_SEQUENTIAL)
+                ::madvise(addr_, mapped_length_, MADV_SEQUENTIAL);
+#endif
+                data_ = static_cast<const CharT*>(addr_);
+                length_ = mapped_length_ / sizeof(CharT);
+            }
+        }
+        ::close(fd);
+    }
+
+    mmap_source(mmap_source&& other)
+        : addr_(other.addr_), mapped_length_(other.mapped_length_), data_(other.data_),
+          length_(other.length_), eof_(other.eof_), error_(other.error_)
+    {
+        other.addr_ = MAP_FAILED;
+        other.mapped_length_ = 0;
+    }
+
+    ~mmap_source()
+    {
+        if (addr_ != MAP_FAILED)
+        {
+            ::munmap(addr_, mapped_length_);
+        }
+    }
+
+    bool eof() const
+    {
+        return eof_;
+    }
+
+    bool is_error() const
+    {
+        return error_;
+    }
+
+    const CharT* data() const
+    {
+        return data_;
+    }
+
+    size_t length() const
+    {
+        return length_;
+    }
+
+    size_t read_buffer(CharT*, size_t, const CharT*& data)
+    {
+        if (eof_ || error_)
+        {
+            return 0;
+        }
+        eof_ = true;
+        data = data_;
+        return length_;
+    }
+};
+
+#endif
+
+}
+
+#endif
@@ -2278,6 +2278,8 @@ struct cbor_Encoder_
             }
 
         case json_type_tag::double_t:
+        case json_type_tag::small_number_text_t:
+        case json_type_tag::number_text_t:
             {
                 action(static_cast<uint8_t>(0xfb), v);
                 action(jval.as_double(),v);
@@ -2292,6 +2294,7 @@ struct cbor_Encoder_
 
         case json_type_tag::small_string_t:
         case json_type_tag::string_t:
+        case json_type_tag::string_view_t:
             {
                 encode_string(jval.as_string_view(), action, v);
                 break;
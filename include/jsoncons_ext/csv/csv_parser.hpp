@@ -699,6 +699,16 @@ all_csv_states:
     {
         return index_;
     }
+
+    size_t line_number() const
+    {
+        return line_;
+    }
+
+    size_t column_number() const
+    {
+        return column_;
+    }
 private:
 
     void trim_string_buffer(bool trim_leading, bool trim_trailing)
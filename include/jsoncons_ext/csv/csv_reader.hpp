@@ -21,11 +21,12 @@
 #include <jsoncons/json.hpp>
 #include <jsoncons/json_reader.hpp>
 #include <jsoncons/json_decoder.hpp>
+#include <jsoncons/source.hpp>
 #include <jsoncons_ext/csv/csv_parameters.hpp>
 
 namespace jsoncons { namespace csv {
 
-template<class CharT,class Allocator=std::allocator<char>>
+template<class CharT,class Allocator=std::allocator<char>,class Src=stream_source<CharT>>
 class basic_csv_reader 
 {
     struct stack_item
@@ -45,10 +46,11 @@ class basic_csv_reader
     basic_csv_reader& operator = (const basic_csv_reader&) = delete; 
 
     basic_csv_parser<CharT,Allocator> parser_;
-    std::basic_istream<CharT>& is_;
+    Src source_;
     std::vector<CharT,char_allocator_type> buffer_;
     size_t buffer_length_;
-    size_t buffer_position_;
+    const CharT* data_;
+    size_t length_;
     bool eof_;
     size_t index_;
 public:
@@ -56,59 +58,67 @@ public:
     static const size_t default_max_buffer_length = 16384;
     //!  Parse an input stream of CSV text into a json object
     /*!
-      \param is The input stream to read from
+      \param source The input stream, or another source, to read from
     */
 
-    basic_csv_reader(std::basic_istream<CharT>& is,
+    template <class Source>
+    basic_csv_reader(Source&& source,
                      basic_json_input_handler<CharT>& handler)
 
        : parser_(handler),
-         is_(is),
+         source_(std::forward<Source>(source)),
          buffer_length_(default_max_buffer_length),
-         buffer_position_(0),
+         data_(nullptr),
+         length_(0),
          eof_(false),
          index_(0)
     {
         buffer_.reserve(buffer_length_);
     }
 
-    basic_csv_reader(std::basic_istream<CharT>& is,
+    template <class Source>
+    basic_csv_reader(Source&& source,
                      basic_json_input_handler<CharT>& handler,
                      basic_csv_parameters<CharT,Allocator> params)
 
        : parser_(handler,params),
-         is_(is),
+         source_(std::forward<Source>(source)),
          buffer_length_(default_max_buffer_length),
-         buffer_position_(0),
+         data_(nullptr),
+         length_(0),
          eof_(false),
          index_(0)
     {
         buffer_.reserve(buffer_length_);
     }
 
-    basic_csv_reader(std::basic_istream<CharT>& is,
+    template <class Source>
+    basic_csv_reader(Source&& source,
                      basic_json_input_handler<CharT>& handler,
                      parse_error_handler& err_handler)
        :
          parser_(handler,err_handler),
-         is_(is),
+         source_(std::forward<Source>(source)),
          buffer_length_(default_max_buffer_length),
-         buffer_position_(0),
+         data_(nullptr),
+         length_(0),
          eof_(false),
          index_(0)
     {
         buffer_.reserve(buffer_length_);
     }
 
-    basic_csv_reader(std::basic_istream<CharT>& is,
+    template <class Source>
+    basic_csv_reader(Source&& source,
                      basic_json_input_handler<CharT>& handler,
                      parse_error_handler& err_handler,
                      basic_csv_parameters<CharT,Allocator> params)
        :
          parser_(handler,err_handler,params),
-         is_(is),
+         source_(std::forward<Source>(source)),
          buffer_length_(default_max_buffer_length),
-         buffer_position_(0),
+         data_(nullptr),
+         length_(0),
          eof_(false),
          index_(0)
     {
@@ -124,15 +134,20 @@ public:
         parser_.reset();
         while (!eof_ && !parser_.done())
         {
-            if (!(index_ < buffer_.size()))
+            if (!(index_ < length_))
             {
-                if (!is_.eof())
+                if (!source_.eof())
                 {
-                    buffer_.clear();
-                    buffer_.resize(buffer_length_);
-                    is_.read(buffer_.data(), buffer_length_);
-                    buffer_.resize(static_cast<size_t>(is_.gcount()));
-                    if (buffer_.size() == 0)
+                    if (source_.is_error())
+                    {
+                        throw parse_error(json_parser_errc::source_error,parser_.line_number(),parser_.column_number());
+                    }
+                    if (buffer_.size() != buffer_length_)
+                    {
+                        buffer_.resize(buffer_length_);
+                    }
+                    length_ = source_.read_buffer(buffer_.data(), buffer_length_, data_);
+                    if (length_ == 0)
                     {
                         eof_ = true;
                     }
@@ -145,7 +160,7 @@ public:
             }
             if (!eof_)
             {
-                parser_.parse(buffer_.data(),index_,buffer_.size());
+                parser_.parse(data_,index_,length_);
                 index_ = parser_.index();
             }
         }
@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <memory>
 #include <jsoncons/json.hpp>
+#include <jsoncons/json_view.hpp>
 #include "jsonpath_filter.hpp"
 #include "jsonpath_error_category.hpp"
 
@@ -38,6 +39,15 @@ Json json_query(const Json& root, const typename Json::string_view_type& path, r
     }
 }
 
+// A view is queried through a basic_json copy of it
+template<class CharT, class Allocator>
+basic_json<CharT> json_query(const basic_json_view<CharT,Allocator>& root, 
+                             const typename basic_json_view<CharT,Allocator>::string_view_type& path, 
+                             result_type result_t = result_type::value)
+{
+    return json_query(root.template as<basic_json<CharT>>(), path, result_t);
+}
+
 template<class Json, class T>
 void json_replace(Json& root, const typename Json::string_view_type& path, T&& new_value)
 {
@@ -220,6 +220,8 @@ public:
             }
 
             case json_type_tag::double_t:
+            case json_type_tag::small_number_text_t:
+            case json_type_tag::number_text_t:
             {
                 // float 64
                 action(static_cast<uint8_t>(msgpack_format::float64_cd), v);
@@ -229,6 +231,7 @@ public:
 
             case json_type_tag::small_string_t:
             case json_type_tag::string_t:
+            case json_type_tag::string_view_t:
             {
                 encode_string(jval.as_string_view(), action, v);
                 break;
@@ -13,6 +13,7 @@
 #include <vector>
 #include <utility>
 #include <ctime>
+#include <cstdlib>
 
 using namespace jsoncons;
 
@@ -173,5 +174,37 @@ BOOST_AUTO_TEST_CASE(test_double_to_wstring)
     s = float_to_string<wchar_t>(x, std::numeric_limits<double>::digits10);
     BOOST_CHECK(s == std::wstring(L"-11.0"));
 }
+BOOST_AUTO_TEST_CASE(test_shortest_round_trip)
+{
+    detail::print_double print(0);
+    const double values[] = {0.1, 0.3, 1.0/3, 2.0/3, 5e-324, 2.2250738585072014e-308, 1.7976931348623157e308,
+                             123456789012345680.0, 9007199254740993.0, 1e23, 4.35, 0.000123, 1e21};
+    for (double x : values)
+    {
+        std::string s;
+        jsoncons::detail::string_writer<char> writer(s);
+        print(x, 0, writer);
+        writer.flush();
+        BOOST_CHECK_MESSAGE(std::strtod(s.c_str(), nullptr) == x, s);
+    }
+
+    std::string s;
+    jsoncons::detail::string_writer<char> writer(s);
+    print(0.1 + 0.2, 0, writer);
+    writer.flush();
+    BOOST_CHECK_EQUAL(std::string("0.30000000000000004"), s);
+}
+
+BOOST_AUTO_TEST_CASE(test_number_format_precision)
+{
+    json j = json::parse(std::string("[1.10,0.377849,1234.5e-2,1.0e20,100.0]"));
+    BOOST_CHECK_EQUAL(std::string("[1.1,0.377849,12.345,1.0e+20,100.0]"), j.to_string());
+
+    json k;
+    k["a"] = 1.0/3;
+    k["b"] = 1e-7;
+    BOOST_CHECK_EQUAL(std::string("{\"a\":0.3333333333333333,\"b\":1.0e-07}"), k.to_string());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,103 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_arena.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+const std::string text = R"(
+{
+    "name" : "A string longer than the short string optimization holds",
+    "values" : [1, -2, 3.5, "another string that needs its own allocation", null, true],
+    "nested" : {"a" : {"b" : ["x", "y", {"c" : "deep string value, also long enough"}]}}
+}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(json_arena_tests)
+
+BOOST_AUTO_TEST_CASE(test_arena_allocate)
+{
+    arena a(64);
+    BOOST_CHECK_EQUAL(0, a.capacity());
+
+    void* p1 = a.allocate(1, 1);
+    void* p2 = a.allocate(8, 8);
+    BOOST_CHECK_EQUAL(0, reinterpret_cast<uintptr_t>(p2) % 8);
+    BOOST_CHECK(static_cast<char*>(p2) > static_cast<char*>(p1));
+    BOOST_CHECK_EQUAL(64, a.capacity());
+
+    // Larger than a block
+    a.allocate(1000, 16);
+    size_t capacity = a.capacity();
+    BOOST_CHECK(capacity >= 1064);
+
+    a.reset();
+    BOOST_CHECK(a.capacity() < capacity);
+    BOOST_CHECK(a.capacity() >= 1000);
+
+    a.release();
+    BOOST_CHECK_EQUAL(0, a.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(test_decode_in_arena)
+{
+    arena a;
+    arena_json& j = decode_in_arena<arena_json>(a, text);
+    BOOST_CHECK(a.capacity() > 0);
+
+    BOOST_CHECK_EQUAL(json::parse(text).to_string(), j.as<std::string>());
+    BOOST_CHECK(j.object_value().get_allocator() == arena_allocator<char>(a));
+    BOOST_CHECK(j["values"][3].as<std::string>() == "another string that needs its own allocation");
+
+    std::istringstream is(text);
+    arena_ojson& k = decode_in_arena<arena_ojson>(a, is);
+    BOOST_CHECK_EQUAL(ojson::parse(text).to_string(), k.as<std::string>());
+
+    BOOST_CHECK_THROW(decode_in_arena<arena_json>(a, std::string("{\"a\":}")), parse_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_arena_reuse)
+{
+    arena a;
+    decode_in_arena<arena_json>(a, text);
+    a.reset();
+    size_t capacity = a.capacity();
+    for (int i = 0; i < 10; ++i)
+    {
+        arena_json& j = decode_in_arena<arena_json>(a, text);
+        BOOST_CHECK_EQUAL(3, j.size());
+        a.reset();
+    }
+    BOOST_CHECK_EQUAL(capacity, a.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(test_arena_json_values)
+{
+    arena a;
+    arena_allocator<char> alloc(a);
+
+    arena_json j = arena_json::object(alloc);
+    j.set("key", arena_json("a value that does not fit in a short string", alloc));
+    j.set("array", arena_json::array(alloc));
+    j["array"].push_back(42);
+
+    // Copies keep the allocator, and so the arena
+    arena_json copy(j);
+    BOOST_CHECK(copy.object_value().get_allocator() == alloc);
+    BOOST_CHECK(copy == j);
+
+    // Default constructed allocators fall back to the heap
+    arena_json heap("a value that does not fit in a short string");
+    BOOST_CHECK(heap == j["key"]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,175 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+// Hands out at most three characters at a time
+class chunked_source
+{
+    std::string s_;
+    size_t pos_;
+public:
+    chunked_source(const std::string& s)
+        : s_(s), pos_(0)
+    {
+    }
+
+    bool eof() const
+    {
+        return pos_ == s_.length();
+    }
+
+    bool is_error() const
+    {
+        return false;
+    }
+
+    size_t read_buffer(char*, size_t, const char*& data)
+    {
+        size_t length = (std::min)(size_t(3), s_.length() - pos_);
+        data = s_.data() + pos_;
+        pos_ += length;
+        return length;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(json_cursor_tests)
+
+BOOST_AUTO_TEST_CASE(test_cursor_events)
+{
+    std::istringstream is("{\"a\":[1,-2,3.5,\"x\\ny\",true,null],\"b\":18446744073709551615}");
+    json_cursor cursor(is);
+
+    std::vector<json_event_type> types;
+    for (; !cursor.done(); cursor.next())
+    {
+        types.push_back(cursor.current().event_type());
+        switch (cursor.current().event_type())
+        {
+        case json_event_type::integer_value:
+            BOOST_CHECK_EQUAL(-2, cursor.current().as_integer());
+            break;
+        case json_event_type::uinteger_value:
+            BOOST_CHECK(cursor.current().as_uinteger() == 1 || cursor.current().as_uinteger() == 18446744073709551615ULL);
+            break;
+        case json_event_type::double_value:
+            BOOST_CHECK_EQUAL(3.5, cursor.current().as_double());
+            break;
+        case json_event_type::string_value:
+            BOOST_CHECK(cursor.current().as_string_view() == "x\ny");
+            break;
+        case json_event_type::bool_value:
+            BOOST_CHECK(cursor.current().as_bool());
+            break;
+        default:
+            break;
+        }
+    }
+
+    std::vector<json_event_type> expected = {
+        json_event_type::begin_object,
+        json_event_type::name,
+        json_event_type::begin_array,
+        json_event_type::uinteger_value,
+        json_event_type::integer_value,
+        json_event_type::double_value,
+        json_event_type::string_value,
+        json_event_type::bool_value,
+        json_event_type::null_value,
+        json_event_type::end_array,
+        json_event_type::name,
+        json_event_type::uinteger_value,
+        json_event_type::end_object
+    };
+    BOOST_CHECK(types == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor_root_scalar)
+{
+    std::istringstream is(" 42 ");
+    json_cursor cursor(is);
+    BOOST_REQUIRE(!cursor.done());
+    BOOST_CHECK(cursor.current().event_type() == json_event_type::uinteger_value);
+    BOOST_CHECK_EQUAL(42, cursor.current().as_integer());
+    cursor.next();
+    BOOST_CHECK(cursor.done());
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor_small_buffer)
+{
+    std::string text = "[\"abcdefghijklmnop\",{\"key\":\"value\"},12345678,[]]";
+    basic_json_cursor<char,std::allocator<char>,chunked_source> cursor(text);
+
+    std::vector<std::string> strings;
+    size_t count = 0;
+    for (; !cursor.done(); cursor.next())
+    {
+        ++count;
+        if (cursor.current().event_type() == json_event_type::string_value ||
+            cursor.current().event_type() == json_event_type::name)
+        {
+            strings.push_back(std::string(cursor.current().as_string_view().data(), cursor.current().as_string_view().length()));
+        }
+    }
+    BOOST_CHECK_EQUAL(10, count);
+    std::vector<std::string> expected = {"abcdefghijklmnop","key","value"};
+    BOOST_CHECK(strings == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor_read_to)
+{
+    std::string text = "[{\"id\":1,\"tags\":[\"a\",\"b\"]},{\"id\":2,\"tags\":[]},3]";
+    basic_json_cursor<char,std::allocator<char>,string_source<char>> cursor(text);
+    BOOST_REQUIRE(cursor.current().event_type() == json_event_type::begin_array);
+    cursor.next();
+
+    std::vector<json> elements;
+    while (cursor.current().event_type() != json_event_type::end_array)
+    {
+        json_decoder<json> decoder;
+        cursor.read_to(decoder);
+        elements.push_back(decoder.get_result());
+        cursor.next();
+    }
+    cursor.next();
+    BOOST_CHECK(cursor.done());
+
+    BOOST_REQUIRE_EQUAL(3, elements.size());
+    BOOST_CHECK(elements[0] == json::parse("{\"id\":1,\"tags\":[\"a\",\"b\"]}"));
+    BOOST_CHECK(elements[1] == json::parse("{\"id\":2,\"tags\":[]}"));
+    BOOST_CHECK_EQUAL(3, elements[2].as<int>());
+}
+
+BOOST_AUTO_TEST_CASE(test_cursor_error)
+{
+    std::istringstream is("[1,2,}");
+    std::error_code ec;
+    json_cursor cursor(is, ec);
+    BOOST_REQUIRE(!ec);
+    while (!cursor.done() && !ec)
+    {
+        cursor.next(ec);
+    }
+    BOOST_CHECK(ec == json_parser_errc::expected_value);
+
+    std::istringstream is2("[1,2");
+    json_cursor cursor2(is2);
+    cursor2.next();
+    BOOST_CHECK_EQUAL(1, cursor2.current().as_integer());
+    BOOST_CHECK_THROW(cursor2.next(), parse_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,172 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_index_parser.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+
+using namespace jsoncons;
+
+namespace {
+
+json index_parse(const std::string& s, std::error_code& ec)
+{
+    json_decoder<json> decoder;
+    json_index_parser parser(decoder);
+    parser.parse(s.data(), s.size(), ec);
+    return ec ? json() : decoder.get_result();
+}
+
+json incremental_parse(const std::string& s, std::error_code& ec)
+{
+    json_decoder<json> decoder;
+    strict_parse_error_handler err_handler;
+    json_parser parser(decoder, err_handler);
+    parser.set_source(s.data(), s.size());
+    parser.parse_some(ec);
+    if (!ec)
+    {
+        parser.end_parse(ec);
+    }
+    if (!ec)
+    {
+        parser.check_done(ec);
+    }
+    return ec ? json() : decoder.get_result();
+}
+
+void check_same_as_incremental(const std::string& s)
+{
+    std::error_code ec1;
+    json expected = incremental_parse(s, ec1);
+    std::error_code ec2;
+    json result = index_parse(s, ec2);
+    BOOST_CHECK_MESSAGE(!ec1 == !ec2, s);
+    if (!ec1 && !ec2)
+    {
+        BOOST_CHECK_MESSAGE(expected.to_string() == result.to_string(), s);
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(json_index_parser_tests)
+
+BOOST_AUTO_TEST_CASE(test_index_parse_values)
+{
+    std::vector<std::string> inputs = {
+        "[1,2,3]",
+        "{\"a\":1,\"b\":[true,false,null],\"c\":{}}",
+        " 1 ",
+        "-0",
+        "1.5e10",
+        "-12.25",
+        "[1.0e+2,1E-2,0.5]",
+        "18446744073709551615",
+        "18446744073709551616",
+        "-9223372036854775808",
+        "-9223372036854775809",
+        "\"a\\\\\\\"b\"",
+        "[\"\\ud83d\\ude00\",\"\\u00e9\"]",
+        "{\"k\\n\":\"v\\t\\/\"}",
+        "\t\r\n[ \r\n1\r\n]\r\n",
+        "[[[]],{},[{}]]",
+        "\"\xE6\x97\xA5\xE6\x9C\xAC\""
+    };
+    for (const auto& s : inputs)
+    {
+        check_same_as_incremental(s);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_index_parse_errors)
+{
+    std::vector<std::pair<std::string,json_parser_errc>> inputs = {
+        {"[1,]", json_parser_errc::extra_comma},
+        {"{\"a\":1,}", json_parser_errc::extra_comma},
+        {"[1 2]", json_parser_errc::expected_comma_or_right_bracket},
+        {"{\"a\" 1}", json_parser_errc::expected_colon},
+        {"{1:1}", json_parser_errc::expected_name},
+        {"truex", json_parser_errc::invalid_value},
+        {"[01]", json_parser_errc::leading_zero},
+        {"[1.]", json_parser_errc::invalid_number},
+        {"[\"abc", json_parser_errc::unexpected_eof},
+        {"[1", json_parser_errc::unexpected_eof},
+        {"[1]x", json_parser_errc::extra_character},
+        {"[\"\x01\"]", json_parser_errc::illegal_control_character},
+        {"\"\\x\"", json_parser_errc::illegal_escaped_character},
+        {"[/* comment */ 1]", json_parser_errc::expected_value},
+        {"[1}", json_parser_errc::expected_comma_or_right_bracket},
+        {"\"\xE6\x41\x41\"", json_parser_errc::expected_continuation_byte}
+    };
+    for (const auto& item : inputs)
+    {
+        std::error_code ec;
+        index_parse(item.first, ec);
+        BOOST_CHECK_MESSAGE(ec == item.second, item.first + ": " + ec.message());
+        check_same_as_incremental(item.first);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_index_parse_block_boundaries)
+{
+    // Escapes, strings and numbers straddling the 64 character blocks of the index
+    for (size_t k = 0; k < 200; ++k)
+    {
+        std::string backslashes(k % 7, '\\');
+        std::string s = "[\"" + std::string(k, 'x') + backslashes + ((k % 7) % 2 ? "\"" : "") + "y\"," + std::to_string(k) + "]";
+        check_same_as_incremental(s);
+
+        std::string t = std::string(k, ' ') + "{\"" + std::string(k, 'a') + "\":" + std::string(k % 64, '1') + ".5}";
+        check_same_as_incremental(t);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_index_parse_error_position)
+{
+    std::string s = "{\n    \"a\" : 1,\r\n    \"b\" : tru\n}";
+    json_decoder<json> decoder;
+    json_index_parser parser(decoder);
+    std::error_code ec;
+    parser.parse(s.data(), s.size(), ec);
+    BOOST_CHECK(ec == json_parser_errc::invalid_value);
+    BOOST_CHECK_EQUAL(3, parser.line_number());
+    BOOST_CHECK_EQUAL(11, parser.column_number());
+}
+
+BOOST_AUTO_TEST_CASE(test_index_parse_max_nesting_depth)
+{
+    std::string s = "[[[[1]]]]";
+    json_index_parser parser;
+    parser.max_nesting_depth(3);
+    std::error_code ec;
+    parser.parse(s.data(), s.size(), ec);
+    BOOST_CHECK(ec == json_parser_errc::max_depth_exceeded);
+}
+
+BOOST_AUTO_TEST_CASE(test_index_parse_wide)
+{
+    std::wstring s = L"{\"name\":\"\\u00e9t\\u00e9\",\"values\":[1,-2,3.5]}";
+    json_decoder<wjson> decoder;
+    wjson_index_parser parser(decoder);
+    parser.parse(s.data(), s.size());
+    wjson j = decoder.get_result();
+    BOOST_CHECK(j[L"name"].as<std::wstring>() == L"\u00e9t\u00e9");
+    BOOST_CHECK_EQUAL(-2, j[L"values"][1].as<int>());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_parse_falls_back_on_comments)
+{
+    json j = json::parse(std::string("// comment\n[1, /* two */ 2]"));
+    BOOST_CHECK_EQUAL(2, j.size());
+    BOOST_CHECK_EQUAL(2, j[1].as<int>());
+
+    BOOST_CHECK_THROW(json::parse(std::string("[1,2")), parse_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_index_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+bool refers_to(const std::vector<char>& buffer, const json& j)
+{
+    json::string_view_type sv = j.as_string_view();
+    return sv.data() >= buffer.data() && sv.data() + sv.length() <= buffer.data() + buffer.size();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(json_insitu_tests)
+
+BOOST_AUTO_TEST_CASE(test_parse_insitu)
+{
+    std::string text = "{\"short\":\"abc\",\"long\":\"" + std::string(40, 'x') + "\",\"escaped\":\"a\\\"b\\\\c\\u00e9\\ud83d\\ude00\",\"values\":[\"\",1,2.5,true,null]}";
+    std::vector<char> buffer(text.begin(), text.end());
+
+    const json j = json::parse_insitu(buffer.data(), buffer.size());
+
+    BOOST_CHECK(j == json::parse(text));
+    BOOST_CHECK(refers_to(buffer, j["short"]));
+    BOOST_CHECK(refers_to(buffer, j["long"]));
+    BOOST_CHECK(refers_to(buffer, j["escaped"]));
+    BOOST_CHECK_EQUAL(std::string("a\"b\\c\xC3\xA9\xF0\x9F\x98\x80"), j["escaped"].as<std::string>());
+    BOOST_CHECK(refers_to(buffer, j["values"][0]));
+    BOOST_CHECK(j["values"][0].empty());
+
+    // Strings are null terminated in the buffer
+    BOOST_CHECK_EQUAL(std::strlen(j["escaped"].as<const char*>()), j["escaped"].as_string_view().length());
+    BOOST_CHECK(std::strcmp(j["short"].as<const char*>(), "abc") == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_insitu_error)
+{
+    std::string text = "{\"a\":\"b\\n\",\"c\":tru}";
+    std::vector<char> buffer(text.begin(), text.end());
+
+    BOOST_CHECK_THROW(json::parse_insitu(buffer.data(), buffer.size()), parse_error);
+
+    json_decoder<json> decoder;
+    json_index_parser parser(decoder);
+    std::vector<char> buffer2(text.begin(), text.end());
+    std::error_code ec;
+    parser.parse_insitu(buffer2.data(), buffer2.size(), ec);
+    BOOST_CHECK(ec == json_parser_errc::invalid_value);
+}
+
+BOOST_AUTO_TEST_CASE(test_string_reference_copy_and_move)
+{
+    std::string s(30, 'a');
+    json j = json::make_string_reference(s.data(), s.length());
+    BOOST_CHECK(j.type_id() == json_type_tag::string_view_t);
+    BOOST_CHECK(j.is_string());
+    BOOST_CHECK(j.as_string_view().data() == s.data());
+
+    json moved(std::move(j));
+    BOOST_CHECK(moved.type_id() == json_type_tag::string_view_t);
+    BOOST_CHECK(moved.as_string_view().data() == s.data());
+
+    // Copies own their characters
+    json copied(moved);
+    BOOST_CHECK(copied.type_id() == json_type_tag::string_t);
+    json small = json::make_string_reference(s.data(), 3);
+    json small_copy = small;
+    BOOST_CHECK(small_copy.type_id() == json_type_tag::small_string_t);
+
+    s[0] = 'b';
+    BOOST_CHECK_EQUAL('b', moved.as_string_view()[0]);
+    BOOST_CHECK_EQUAL('a', copied.as_string_view()[0]);
+    BOOST_CHECK(copied != moved);
+
+    json arr = json::array();
+    arr.push_back(std::move(moved));
+    arr.push_back(json::make_string_reference(s.data(), 2));
+    BOOST_CHECK(arr[0].type_id() == json_type_tag::string_view_t);
+    BOOST_CHECK_EQUAL(std::string("[\"b" + std::string(29, 'a') + "\",\"ba\"]"), arr.to_string());
+
+    arr[0].swap(arr[1]);
+    BOOST_CHECK_EQUAL(std::string("ba"), arr[0].as<std::string>());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -191,6 +191,34 @@ BOOST_AUTO_TEST_CASE(test_multiple)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_decode_nested_duplicate_names)
+{
+    std::string in = R"({"c":1,"a":[{"z":1,"y":[2,{"x":null}],"z":3}],"b":{"d":[[],{}]},"a":4,"c":[5]})";
+
+    json j = json::parse(in);
+    BOOST_CHECK(j == json::parse(R"({"a":4,"b":{"d":[[],{}]},"c":[5]})"));
+
+    ojson k = ojson::parse(in);
+    BOOST_CHECK_EQUAL(std::string(R"({"b":{"d":[[],{}]},"a":4,"c":[5]})"), k.to_string());
+
+    json l = json::parse(R"([{"z":1,"y":[2,{"x":null}],"z":3}])");
+    BOOST_CHECK_EQUAL(std::string(R"([{"y":[2,{"x":null}],"z":3}])"), l.to_string());
+
+    // More members than the small object path handles
+    std::string big = "{";
+    for (int i = 40; i > 0; --i)
+    {
+        big += "\"k" + std::to_string(i % 30) + "\":" + std::to_string(i) + (i > 1 ? "," : "}");
+    }
+    json m = json::parse(big);
+    BOOST_CHECK_EQUAL(30, m.size());
+    BOOST_CHECK_EQUAL(10, m["k10"].as<int>());
+    BOOST_CHECK_EQUAL(30, m["k0"].as<int>());
+    ojson n = ojson::parse(big);
+    BOOST_CHECK_EQUAL(30, n.size());
+    BOOST_CHECK_EQUAL(10, n["k10"].as<int>());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -0,0 +1,140 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_filter.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <set>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+// Passes through the top level members with the given names and skips the others
+class projection_filter : public json_filter
+{
+    std::set<std::string> names_;
+    size_t level_;
+public:
+    size_t skipped;
+
+    projection_filter(json_input_handler& handler, const std::set<std::string>& names)
+        : json_filter(handler), names_(names), level_(0), skipped(0)
+    {
+    }
+
+private:
+    void do_begin_object(const parsing_context& context) override
+    {
+        ++level_;
+        this->downstream_handler().begin_object(context);
+    }
+
+    void do_end_object(const parsing_context& context) override
+    {
+        --level_;
+        this->downstream_handler().end_object(context);
+    }
+
+    void do_name(const string_view_type& name, const parsing_context& context) override
+    {
+        if (level_ == 1 && names_.count(std::string(name)) == 0 && context.skip_value())
+        {
+            ++skipped;
+            return;
+        }
+        this->downstream_handler().name(name, context);
+    }
+};
+
+// Skips the contents of every array
+class empty_arrays_filter : public json_filter
+{
+public:
+    empty_arrays_filter(json_input_handler& handler)
+        : json_filter(handler)
+    {
+    }
+
+private:
+    void do_begin_array(const parsing_context& context) override
+    {
+        this->downstream_handler().begin_array(context);
+        context.skip_value();
+    }
+};
+
+const std::string text = R"(
+{
+    "id" : 1,
+    "payload" : {"a" : [1, 2.5, {"b" : "}]\"x"}], "c" : "d\\"},
+    "name" : "n",
+    "big" : [1, [2, [3, {}]], "]"],
+    "flag" : true,
+    "number" : -12.5e3,
+    "tail" : "t"
+}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(json_parser_skip_tests)
+
+BOOST_AUTO_TEST_CASE(test_skip_members)
+{
+    for (size_t buffer_length : {3, 7, 16384})
+    {
+        json_decoder<json> decoder;
+        projection_filter filter(decoder, {"id","name","tail"});
+        std::istringstream is(text);
+        json_reader reader(is, filter);
+        reader.buffer_length(buffer_length);
+        reader.read();
+
+        BOOST_CHECK_EQUAL(4, filter.skipped);
+        BOOST_CHECK(decoder.get_result() == json::parse(R"({"id":1,"name":"n","tail":"t"})"));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_skip_array_contents)
+{
+    for (size_t buffer_length : {2, 16384})
+    {
+        json_decoder<json> decoder;
+        empty_arrays_filter filter(decoder);
+        std::istringstream is(text);
+        json_reader reader(is, filter);
+        reader.buffer_length(buffer_length);
+        reader.read();
+
+        json expected = json::parse(text);
+        expected["payload"]["a"] = json::array();
+        expected["big"] = json::array();
+        BOOST_CHECK(decoder.get_result() == expected);
+    }
+
+    json_decoder<json> decoder;
+    empty_arrays_filter filter(decoder);
+    std::istringstream is("[1,[2,3],\"]\"]");
+    json_reader reader(is, filter);
+    reader.read();
+    BOOST_CHECK(decoder.get_result() == json::array());
+}
+
+BOOST_AUTO_TEST_CASE(test_skip_then_error)
+{
+    json_decoder<json> decoder;
+    projection_filter filter(decoder, {"b"});
+    std::istringstream is("{\"a\":[1,\n2,\n3],\n\"b\":}");
+    json_reader reader(is, filter);
+    std::error_code ec;
+    reader.read(ec);
+    BOOST_CHECK(ec == json_parser_errc::expected_value);
+    BOOST_CHECK_EQUAL(4, reader.line_number());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
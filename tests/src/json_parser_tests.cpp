@@ -254,6 +254,63 @@ BOOST_AUTO_TEST_CASE(test_array_string)
     json j = decoder.get_result();
 }
 
+BOOST_AUTO_TEST_CASE(test_whitespace_line_numbers)
+{
+    std::string input = "[\r\n  1,\r  2,\n\n  3 ,\r\n\r\n     \t  \"abc\"\r\n  , 1.5\r\n , -2 \n\n ]   \n  x";
+
+    // CR LF pairs and indentation runs split at every chunk boundary
+    for (size_t i = 1; i <= input.length(); ++i)
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_reader reader(is, decoder);
+        reader.buffer_length(i);
+        try
+        {
+            reader.read();
+            BOOST_CHECK_MESSAGE(false, "Expected parse_error");
+        }
+        catch (const parse_error& e)
+        {
+            BOOST_CHECK_EQUAL(11, e.line_number());
+            BOOST_CHECK_EQUAL(3, e.column_number());
+        }
+        BOOST_REQUIRE(decoder.is_valid());
+        json j = decoder.get_result();
+        BOOST_REQUIRE(j.is_array());
+        BOOST_CHECK_EQUAL(6, j.size());
+        BOOST_CHECK_EQUAL(std::string("abc"), j[3].as<std::string>());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_long_indentation_runs)
+{
+    std::string input = "{\n" + std::string(70, ' ') + "\"a\" :\t" + std::string(45, '\t') + "[1,\n" + std::string(33, ' ') + "2]\n}";
+
+    for (size_t i = 1; i <= input.length(); i += 7)
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_reader reader(is, decoder);
+        reader.buffer_length(i);
+        reader.read();
+        json j = decoder.get_result();
+        BOOST_CHECK_EQUAL(2, j["a"][1].as<int>());
+    }
+
+    std::string bad = "[\n" + std::string(40, ' ') + "1,\n" + std::string(40, ' ') + "}";
+    try
+    {
+        json::parse(bad);
+        BOOST_CHECK_MESSAGE(false, "Expected parse_error");
+    }
+    catch (const parse_error& e)
+    {
+        BOOST_CHECK_EQUAL(3, e.line_number());
+        BOOST_CHECK_EQUAL(41, e.column_number());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -0,0 +1,105 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reclaimer.hpp>
+#include <string>
+#include <thread>
+
+using namespace jsoncons;
+
+namespace {
+
+template <class Json>
+Json make_nested_arrays(size_t depth)
+{
+    Json val = typename Json::array();
+    for (size_t i = 0; i < depth; ++i)
+    {
+        Json outer = typename Json::array();
+        outer.reserve(2);
+        outer.push_back(i);
+        outer.push_back(std::move(val));
+        val = std::move(outer);
+    }
+    return val;
+}
+
+template <class Json>
+Json make_nested_objects(size_t depth)
+{
+    Json val;
+    for (size_t i = 0; i < depth; ++i)
+    {
+        Json outer;
+        outer["id"] = i;
+        outer["child"] = std::move(val);
+        val = std::move(outer);
+    }
+    return val;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(json_reclaimer_tests)
+
+BOOST_AUTO_TEST_CASE(test_destroy_deeply_nested)
+{
+    // Deep enough to overflow the call stack if destroyed recursively
+    const size_t depth = 1000000;
+    {
+        json val = make_nested_arrays<json>(depth);
+        BOOST_CHECK_EQUAL(depth-2, val[1][0].as<size_t>());
+    }
+    {
+        ojson val = make_nested_objects<ojson>(depth);
+        BOOST_CHECK_EQUAL(depth-1, val["id"].as<size_t>());
+    }
+    {
+        json val = make_nested_objects<json>(depth);
+        val = json::null();
+        BOOST_CHECK(val.is_null());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_destroy_shared_nested)
+{
+    shared_json val = make_nested_arrays<shared_json>(1000);
+    shared_json copy = val;
+    const shared_json& inner = copy[1][1];
+
+    // Destroying val releases the arrays copy still refers to
+    val = shared_json::null();
+    BOOST_CHECK_EQUAL(997, inner[0].as<int>());
+    BOOST_CHECK_EQUAL(996, inner[1][0].as<int>());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_reclaimer)
+{
+    json_reclaimer<json> reclaimer;
+
+    json val = json::parse(R"({"a":[1,2,{"b":"a string longer than the inline buffer"}],"c":{"d":null}})");
+    reclaimer.reclaim(val);
+    BOOST_CHECK(val.is_null());
+
+    json deep = make_nested_arrays<json>(100000);
+    reclaimer.reclaim(std::move(deep));
+    reclaimer.wait();
+
+    std::thread producer([&reclaimer]()
+    {
+        for (size_t i = 0; i < 100; ++i)
+        {
+            reclaimer.reclaim(make_nested_objects<json>(10));
+        }
+    });
+    producer.join();
+    reclaimer.wait();
+
+    // Values still queued are destroyed with the reclaimer
+    json_reclaimer<ojson> other;
+    other.reclaim(make_nested_objects<ojson>(1000));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
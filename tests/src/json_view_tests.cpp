@@ -0,0 +1,167 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_view.hpp>
+#include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
+#include <jsoncons_ext/jsonpath/json_query.hpp>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+const std::string store = R"(
+{
+    "store": {
+        "book": [
+            {"category": "reference", "author": "Nigel Rees", "title": "Sayings of the Century", "price": 8.95},
+            {"category": "fiction", "author": "Evelyn Waugh", "title": "Sword of Honour", "price": 12.99},
+            {"category": "fiction", "author": "Herman Melville", "title": "Moby Dick", "isbn": "0-553-21311-3", "price": 8.99}
+        ],
+        "bicycle": {"color": "red", "price": 19.95},
+        "empty": {},
+        "none": []
+    },
+    "count": 3,
+    "big": 18446744073709551615,
+    "negative": -5,
+    "flag": true,
+    "nothing": null
+}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(json_view_tests)
+
+BOOST_AUTO_TEST_CASE(test_json_view_accessors)
+{
+    json_tape tape = json_tape::parse(store);
+    json_view root = tape.root();
+
+    BOOST_REQUIRE(root.is_object());
+    BOOST_CHECK_EQUAL(6, root.size());
+    BOOST_CHECK(root.has_key("store"));
+    BOOST_CHECK(!root.has_key("shop"));
+    BOOST_CHECK_THROW(root.at("shop"), key_not_found);
+
+    json_view books = root["store"]["book"];
+    BOOST_REQUIRE(books.is_array());
+    BOOST_CHECK_EQUAL(3, books.size());
+    BOOST_CHECK_EQUAL(std::string("Moby Dick"), books.at(2).at("title").as<std::string>());
+    BOOST_CHECK(books[1]["author"].as_string_view() == "Evelyn Waugh");
+    BOOST_CHECK_EQUAL(8.95, books[0]["price"].as<double>());
+    BOOST_CHECK_THROW(books.at(3), std::out_of_range);
+
+    BOOST_CHECK_EQUAL(3, root["count"].as<int>());
+    BOOST_CHECK(root["count"].is<int>());
+    BOOST_CHECK(root["big"].is_uinteger());
+    BOOST_CHECK_EQUAL((std::numeric_limits<uint64_t>::max)(), root["big"].as<uint64_t>());
+    BOOST_CHECK_EQUAL(-5, root["negative"].as<int64_t>());
+    BOOST_CHECK(root["flag"].as<bool>());
+    BOOST_CHECK(root["nothing"].is_null());
+
+    BOOST_CHECK(root["store"]["empty"].is_object());
+    BOOST_CHECK(root["store"]["empty"].empty());
+    BOOST_CHECK(root["store"]["none"].is_array());
+    BOOST_CHECK(root["store"]["none"].array_range().begin() == root["store"]["none"].array_range().end());
+
+    auto it = root["store"]["bicycle"].find("price");
+    BOOST_REQUIRE(it != root["store"]["bicycle"].object_range().end());
+    BOOST_CHECK(it->key() == "price");
+    BOOST_CHECK_EQUAL(19.95, it->value().as_double());
+}
+
+BOOST_AUTO_TEST_CASE(test_json_view_ranges)
+{
+    json_tape tape = json_tape::parse(store);
+    json_view root = tape.root();
+
+    std::vector<std::string> titles;
+    for (auto book : root["store"]["book"].array_range())
+    {
+        titles.push_back(book["title"].as<std::string>());
+    }
+    BOOST_REQUIRE_EQUAL(3, titles.size());
+    BOOST_CHECK_EQUAL(std::string("Sword of Honour"), titles[1]);
+
+    // Members in document order, siblings found by skipping whole subtrees
+    std::vector<std::string> names;
+    for (const auto& member : root.object_range())
+    {
+        names.push_back(std::string(member.key().data(), member.key().length()));
+    }
+    std::vector<std::string> expected = {"store","count","big","negative","flag","nothing"};
+    BOOST_CHECK(names == expected);
+
+    json_tape numbers = json_tape::parse("[1,2,3]");
+    std::vector<int> v = numbers.root().as<std::vector<int>>();
+    BOOST_CHECK(v == std::vector<int>({1,2,3}));
+
+    json_tape prices = json_tape::parse(R"({"a":1.5,"b":2.5})");
+    std::map<std::string,double> m = prices.root().as<std::map<std::string,double>>();
+    BOOST_CHECK_EQUAL(2.5, m["b"]);
+}
+
+BOOST_AUTO_TEST_CASE(test_json_view_round_trip)
+{
+    json j = json::parse(store);
+    json_tape tape = json_tape::parse(store);
+
+    BOOST_CHECK(tape.root().as<json>() == j);
+    // Serialized in document order
+    BOOST_CHECK_EQUAL(std::string(R"({"color":"red","price":19.95})"),
+                      tape.root()["store"]["bicycle"].as<std::string>());
+
+    ojson o = tape.root().as<ojson>();
+    BOOST_CHECK_EQUAL(ojson::parse(store).to_string(), o.to_string());
+
+    std::istringstream is(store);
+    json_tape from_stream = json_tape::parse(is);
+    BOOST_CHECK(from_stream.root() == tape.root());
+    BOOST_CHECK(tape.root()["store"] != tape.root()["store"]["bicycle"]);
+
+    json_tape reordered = json_tape::parse(R"({"b":[1,2.0],"a":"x"})");
+    json_tape original = json_tape::parse(R"({"a":"x","b":[1,2]})");
+    BOOST_CHECK(reordered.root() == original.root());
+
+    // Scalars at the top level and an empty tape
+    BOOST_CHECK_EQUAL(std::string("\"text\""), json_tape::parse("\"text\"").root().to_string());
+    BOOST_CHECK(json_tape().root().is_null());
+
+    // Input the index parser rejects is parsed again to report the error
+    BOOST_CHECK_THROW(json_tape::parse("[1,2,]"), parse_error);
+
+    wjson_tape wtape = wjson_tape::parse(L"{\"name\":[\"value\"]}");
+    BOOST_CHECK(wtape.root()[L"name"][0].as<std::wstring>() == L"value");
+}
+
+BOOST_AUTO_TEST_CASE(test_json_view_jsonpointer)
+{
+    json_tape tape = json_tape::parse(store);
+
+    std::error_code ec;
+    json_view author = jsonpointer::get(tape.root(), "/store/book/1/author", ec);
+    BOOST_REQUIRE(!ec);
+    BOOST_CHECK(author.as_string_view() == "Evelyn Waugh");
+
+    BOOST_CHECK(jsonpointer::contains(tape.root(), "/store/book/2/isbn"));
+    BOOST_CHECK(!jsonpointer::contains(tape.root(), "/store/book/0/isbn"));
+    jsonpointer::get(tape.root(), "/store/book/3", ec);
+    BOOST_CHECK(ec);
+}
+
+BOOST_AUTO_TEST_CASE(test_json_view_jsonpath)
+{
+    json_tape tape = json_tape::parse(store);
+
+    json result = jsonpath::json_query(tape.root(), "$.store.book[?(@.price < 10)].title");
+    BOOST_CHECK(result == json::parse(R"(["Sayings of the Century","Moby Dick"])"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_filter.hpp>
+#include <jsoncons/json_index_parser.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+const std::string text = R"({"big":123456789012345678901234567890,"count":10,"neg":-0.50,"price":1.10,"ratio":2.5e-3,"values":[1.0,-7,3.14159265358979323846264]})";
+
+json decode_lazily(const std::string& s)
+{
+    json_decoder<json> decoder;
+    decoder.lazy_numbers(true);
+    std::istringstream is(s);
+    json_reader reader(is, decoder);
+    reader.read();
+    return decoder.get_result();
+}
+
+json decode_lazily_with_index_parser(const std::string& s)
+{
+    json_decoder<json> decoder;
+    decoder.lazy_numbers(true);
+    json_index_parser parser(decoder);
+    parser.parse(s.data(), s.length());
+    return decoder.get_result();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(lazy_number_tests)
+
+BOOST_AUTO_TEST_CASE(test_lazy_numbers_round_trip)
+{
+    json j = decode_lazily(text);
+    json k = decode_lazily_with_index_parser(text);
+
+    // Serialized as they were read
+    BOOST_CHECK_EQUAL(text, j.to_string());
+    BOOST_CHECK_EQUAL(text, k.to_string());
+
+    BOOST_CHECK(j["price"].type_id() == json_type_tag::small_number_text_t);
+    BOOST_CHECK(j["values"][2].type_id() == json_type_tag::number_text_t);
+    BOOST_CHECK(k["big"].type_id() == json_type_tag::number_text_t);
+    // Integers that fit are converted as before
+    BOOST_CHECK(j["count"].type_id() == json_type_tag::uinteger_t);
+    BOOST_CHECK(j["values"][1].type_id() == json_type_tag::integer_t);
+
+    BOOST_CHECK(j["neg"].as_number_text() == "-0.50");
+    BOOST_CHECK(k["values"][2].as_number_text() == "3.14159265358979323846264");
+
+    // Copies, swaps and assignment keep the text
+    json copy = j;
+    BOOST_CHECK_EQUAL(text, copy.to_string());
+    json a("a string longer than the inline buffer");
+    a.swap(copy["values"][2]);
+    BOOST_CHECK(a.as_number_text() == "3.14159265358979323846264");
+    BOOST_CHECK_EQUAL(std::string("a string longer than the inline buffer"), copy["values"][2].as<std::string>());
+    copy["ratio"] = j["big"];
+    BOOST_CHECK(copy["ratio"].as_number_text() == "123456789012345678901234567890");
+}
+
+BOOST_AUTO_TEST_CASE(test_lazy_numbers_access)
+{
+    const json j = decode_lazily(text);
+    const json eager = json::parse(text);
+
+    BOOST_CHECK(j == eager);
+    BOOST_CHECK(eager == j);
+    BOOST_CHECK(j["price"].is_double());
+    BOOST_CHECK(j["price"].is_number());
+    BOOST_CHECK(j["price"].is<double>());
+    BOOST_CHECK(!j["price"].is_string());
+
+    BOOST_CHECK_EQUAL(eager["price"].as<double>(), j["price"].as<double>());
+    BOOST_CHECK_EQUAL(eager["ratio"].as<double>(), j["ratio"].as<double>());
+    BOOST_CHECK_EQUAL(eager["big"].as<double>(), j["big"].as<double>());
+    BOOST_CHECK_EQUAL(eager["values"][2].as<double>(), j["values"][2].as<double>());
+    BOOST_CHECK_EQUAL(-0.5, j["neg"].as<double>());
+    BOOST_CHECK_EQUAL(1, j["price"].as<int>());
+    BOOST_CHECK(j["price"].as<bool>());
+
+    BOOST_CHECK_EQUAL(eager["price"].precision(), j["price"].precision());
+    BOOST_CHECK_EQUAL(eager["price"].decimal_places(), j["price"].decimal_places());
+    BOOST_CHECK_EQUAL(eager["values"][2].precision(), j["values"][2].precision());
+
+    BOOST_CHECK(json::make_number_text("1.10", 4) == json(1.1));
+    BOOST_CHECK(json(1) == json::make_number_text("1.0", 3));
+    BOOST_CHECK(json::make_number_text("1e2", 3) == json::make_number_text("100.0", 5));
+    BOOST_CHECK_THROW(json(1.5).as_number_text(), std::runtime_error);
+
+    // Handlers that do not take number text receive doubles
+    std::vector<uint8_t> v;
+    cbor::encode_cbor(j, v);
+    BOOST_CHECK(cbor::decode_cbor<json>(v) == eager);
+
+    wjson w = wjson::make_number_text(L"-2.50", 5);
+    BOOST_CHECK(w.to_string() == L"-2.50");
+    BOOST_CHECK_EQUAL(-2.5, w.as<double>());
+}
+
+BOOST_AUTO_TEST_CASE(test_lazy_numbers_through_filter)
+{
+    json_decoder<json> decoder;
+    decoder.lazy_numbers(true);
+    rename_object_member_filter filter("price", "cost", decoder);
+    std::istringstream is(text);
+    json_reader reader(is, filter);
+    reader.read();
+    json j = decoder.get_result();
+    BOOST_CHECK(j["cost"].as_number_text() == "1.10");
+
+    // Without the mode, numbers are converted as before
+    json_decoder<json> eager_decoder;
+    std::istringstream eager_is(text);
+    json_reader eager_reader(eager_is, eager_decoder);
+    eager_reader.read();
+    BOOST_CHECK(eager_decoder.get_result()["price"].type_id() == json_type_tag::double_t);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
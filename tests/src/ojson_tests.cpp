@@ -107,5 +107,56 @@ BOOST_AUTO_TEST_CASE(test_object_emplace)
     o.erase("unit_type");
 }
 
+BOOST_AUTO_TEST_CASE(test_wide_object_lookup)
+{
+    // Enough members for the hash index
+    const size_t n = 1000;
+    ojson o;
+    for (size_t i = 0; i < n; ++i)
+    {
+        o.insert_or_assign("key" + std::to_string(i), i);
+    }
+    BOOST_CHECK_EQUAL(n, o.size());
+    BOOST_CHECK_EQUAL(std::string("key0"), o.object_range().begin()->key());
+    for (size_t i = 0; i < n; ++i)
+    {
+        BOOST_CHECK_EQUAL(i, o["key" + std::to_string(i)].as<size_t>());
+    }
+    BOOST_CHECK(o.find("key1000") == o.object_range().end());
+
+    o.insert_or_assign("key500", "replaced");
+    BOOST_CHECK_EQUAL(n, o.size());
+    BOOST_CHECK_EQUAL(std::string("replaced"), o["key500"].as<std::string>());
+
+    // Erasing and inserting before other members shift positions
+    o.erase("key0");
+    o.erase("key10");
+    BOOST_CHECK_EQUAL(n-2, o.size());
+    BOOST_CHECK(o.find("key0") == o.object_range().end());
+    BOOST_CHECK_EQUAL(999, o["key999"].as<int>());
+
+    auto it = o.find("key100");
+    o.try_emplace(it, "inserted", 1);
+    BOOST_CHECK_EQUAL(std::string("inserted"), (o.find("key100") - 1)->key());
+    BOOST_CHECK_EQUAL(101, o["key101"].as<int>());
+    BOOST_CHECK_EQUAL(1, o["inserted"].as<int>());
+
+    // Copies, swaps and parsed objects find their members too
+    ojson copy = o;
+    BOOST_CHECK(copy == o);
+    BOOST_CHECK_EQUAL(998, copy["key998"].as<int>());
+
+    ojson parsed = ojson::parse(o.to_string());
+    BOOST_CHECK(parsed == o);
+    BOOST_CHECK_EQUAL(2, parsed["key2"].as<int>());
+
+    ojson other;
+    other.swap(copy);
+    BOOST_CHECK_EQUAL(3, other["key3"].as<int>());
+
+    o.object_value().clear();
+    BOOST_CHECK(o.find("key3") == o.object_range().end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
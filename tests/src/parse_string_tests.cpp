@@ -134,6 +134,156 @@ BOOST_AUTO_TEST_CASE(test_parse_big_string2)
     //}
 }
 
+BOOST_AUTO_TEST_CASE(test_parse_long_string_escape_positions)
+{
+    // Escapes at every offset of a string longer than one 16 or 32 byte block
+    for (size_t pos = 0; pos < 70; ++pos)
+    {
+        std::string expected(70, 'a');
+        expected[pos] = '\"';
+        std::string input = "\"" + expected.substr(0,pos) + "\\\"" + expected.substr(pos+1) + "\"";
+
+        json j = json::parse(input);
+        BOOST_CHECK_EQUAL(expected, j.as<std::string>());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_long_string_control_character)
+{
+    std::string input = "[\"" + std::string(40, 'a') + "\x01" + std::string(40, 'b') + "\"]";
+
+    std::error_code ec;
+    json_decoder<json> decoder;
+    json_parser parser(decoder);
+    parser.set_source(input.data(), input.length());
+    parser.parse_some(ec);
+    BOOST_CHECK(ec == json_parser_errc::illegal_control_character);
+    BOOST_CHECK_EQUAL(44, parser.column_number());
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_long_string_non_ascii)
+{
+    std::string expected = std::string(33, 'a') + "\xe6\x97\xa5\xd1\x88" + std::string(33, 'b');
+    json j = json::parse("\"" + expected + "\"");
+    BOOST_CHECK_EQUAL(expected, j.as<std::string>());
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_long_string_chunked)
+{
+    std::string expected = std::string(50, 'x') + "\\" + std::string(50, 'y');
+    std::string input = "{\"" + std::string(40, 'k') + "\":\"" + std::string(50, 'x') + "\\\\" + std::string(50, 'y') + "\"}";
+
+    for (size_t i = 1; i < input.length(); ++i)
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_reader reader(is, decoder);
+        reader.buffer_length(i);
+        reader.read();
+        BOOST_REQUIRE(decoder.is_valid());
+        json j = decoder.get_result();
+        BOOST_CHECK_EQUAL(expected, j[std::string(40, 'k')].as<std::string>());
+    }
+}
+
+class string_source_recorder : public json_input_handler
+{
+public:
+    struct event
+    {
+        std::string value;
+        bool in_source;
+    };
+
+    const char* first_;
+    const char* last_;
+    std::vector<event> events_;
+
+    string_source_recorder()
+        : first_(nullptr), last_(nullptr)
+    {
+    }
+
+    void source(const char* data, size_t length)
+    {
+        first_ = data;
+        last_ = data + length;
+    }
+private:
+    void record(const string_view_type& s)
+    {
+        event e = {std::string(s.data(), s.length()), s.data() >= first_ && s.data() + s.length() <= last_};
+        events_.push_back(e);
+    }
+
+    void do_begin_json() override {}
+    void do_end_json() override {}
+    void do_begin_object(const parsing_context&) override {}
+    void do_end_object(const parsing_context&) override {}
+    void do_begin_array(const parsing_context&) override {}
+    void do_end_array(const parsing_context&) override {}
+    void do_name(const string_view_type& name, const parsing_context&) override
+    {
+        record(name);
+    }
+    void do_null_value(const parsing_context&) override {}
+    void do_string_value(const string_view_type& value, const parsing_context&) override
+    {
+        record(value);
+    }
+    void do_byte_string_value(const uint8_t*, size_t, const parsing_context&) override {}
+    void do_double_value(double, const number_format&, const parsing_context&) override {}
+    void do_integer_value(int64_t, const parsing_context&) override {}
+    void do_uinteger_value(uint64_t, const parsing_context&) override {}
+    void do_bool_value(bool, const parsing_context&) override {}
+};
+
+BOOST_AUTO_TEST_CASE(test_parse_string_views_into_source)
+{
+    std::string input = "{\"name\":\"value\",\"escaped\":\"a\\nb\",\"list\":[\"" + std::string(40, 'x') + "\",\"\"]}";
+
+    string_source_recorder recorder;
+    json_parser parser(recorder);
+    recorder.source(input.data(), input.length());
+    parser.set_source(input.data(), input.length());
+    parser.parse_some();
+    parser.end_parse();
+
+    BOOST_REQUIRE_EQUAL(7, recorder.events_.size());
+    BOOST_CHECK_EQUAL(std::string("name"), recorder.events_[0].value);
+    BOOST_CHECK(recorder.events_[0].in_source);
+    BOOST_CHECK(recorder.events_[1].in_source);
+    BOOST_CHECK(recorder.events_[2].in_source);
+    BOOST_CHECK_EQUAL(std::string("a\nb"), recorder.events_[3].value);
+    BOOST_CHECK(!recorder.events_[3].in_source);
+    BOOST_CHECK(recorder.events_[4].in_source);
+    BOOST_CHECK(recorder.events_[5].in_source);
+    BOOST_CHECK(recorder.events_[6].value.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_string_views_across_chunks)
+{
+    std::string chunk1 = "[\"abc\",\"de";
+    std::string chunk2 = "f\",\"ghi\"]";
+
+    string_source_recorder recorder;
+    json_parser parser(recorder);
+    recorder.source(chunk1.data(), chunk1.length());
+    parser.set_source(chunk1.data(), chunk1.length());
+    parser.parse_some();
+    recorder.source(chunk2.data(), chunk2.length());
+    parser.set_source(chunk2.data(), chunk2.length());
+    parser.parse_some();
+    parser.end_parse();
+
+    BOOST_REQUIRE_EQUAL(3, recorder.events_.size());
+    BOOST_CHECK(recorder.events_[0].in_source);
+    BOOST_CHECK_EQUAL(std::string("def"), recorder.events_[1].value);
+    BOOST_CHECK(!recorder.events_[1].in_source);
+    BOOST_CHECK_EQUAL(std::string("ghi"), recorder.events_[2].value);
+    BOOST_CHECK(recorder.events_[2].in_source);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -0,0 +1,119 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+const std::string config = R"(
+{
+    "limits": {"requests": 100, "burst": [1,2,3]},
+    "routes": [{"path": "/a", "weight": 1}, {"path": "/b", "weight": 2}],
+    "name": "a service configuration"
+}
+)";
+
+template <class Json>
+const Json& as_const(const Json& j)
+{
+    return j;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(shared_json_tests)
+
+BOOST_AUTO_TEST_CASE(test_copy_shares)
+{
+    shared_json a = shared_json::parse(config);
+    shared_json b = a;
+
+    BOOST_CHECK(&as_const(a).object_value() == &as_const(b).object_value());
+    BOOST_CHECK(a == b);
+
+    // Changing one copy clones the path to the change and nothing else
+    b["limits"]["requests"] = 200;
+    BOOST_CHECK_EQUAL(100, a["limits"]["requests"].as<int>());
+    BOOST_CHECK_EQUAL(200, b["limits"]["requests"].as<int>());
+    BOOST_CHECK(&as_const(a).object_value() != &as_const(b).object_value());
+    BOOST_CHECK(&as_const(a)["limits"].object_value() != &as_const(b)["limits"].object_value());
+    BOOST_CHECK(&as_const(a)["routes"].array_value() == &as_const(b)["routes"].array_value());
+    BOOST_CHECK(&as_const(a)["limits"]["burst"].array_value() == &as_const(b)["limits"]["burst"].array_value());
+
+    b["routes"][1]["weight"] = 3;
+    BOOST_CHECK_EQUAL(2, a["routes"][1]["weight"].as<int>());
+    BOOST_CHECK_EQUAL(3, b["routes"][1]["weight"].as<int>());
+    BOOST_CHECK(&as_const(a)["routes"][0].object_value() == &as_const(b)["routes"][0].object_value());
+
+    b["routes"].add(shared_json::parse(R"({"path": "/c"})"));
+    BOOST_CHECK_EQUAL(2, a["routes"].size());
+    BOOST_CHECK_EQUAL(3, b["routes"].size());
+
+    // A copy that is the last owner changes in place
+    shared_json c = shared_json::parse(config);
+    const shared_json::object* p = &as_const(c).object_value();
+    c["name"] = "another";
+    BOOST_CHECK(p == &as_const(c).object_value());
+}
+
+BOOST_AUTO_TEST_CASE(test_assignment_and_erase)
+{
+    shared_json a = shared_json::parse(config);
+    shared_json b;
+    b = a;
+    b.erase("routes");
+    BOOST_CHECK(a.has_key("routes"));
+    BOOST_CHECK(!b.has_key("routes"));
+
+    shared_json c(a["routes"]);
+    c.erase(c.array_range().begin());
+    BOOST_CHECK_EQUAL(2, a["routes"].size());
+    BOOST_CHECK_EQUAL(1, c.size());
+
+    shared_ojson o = shared_ojson::parse(config);
+    shared_ojson p = o;
+    p["limits"].insert_or_assign("burst", 5);
+    BOOST_CHECK_EQUAL(std::string(R"({"requests":100,"burst":[1,2,3]})"), o["limits"].to_string());
+    BOOST_CHECK_EQUAL(std::string(R"({"requests":100,"burst":5})"), p["limits"].to_string());
+}
+
+BOOST_AUTO_TEST_CASE(test_copies_across_threads)
+{
+    const shared_json snapshot = shared_json::parse(config);
+
+    std::vector<std::thread> workers;
+    std::vector<shared_json> results(4);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        workers.push_back(std::thread([&snapshot,&results,i]()
+        {
+            for (int k = 0; k < 1000; ++k)
+            {
+                shared_json copy = snapshot;
+                copy["limits"]["requests"] = static_cast<int>(i);
+                copy["routes"][0]["weight"] = k;
+                results[i] = copy;
+            }
+        }));
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    BOOST_CHECK(snapshot == shared_json::parse(config));
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(i, results[i]["limits"]["requests"].as<size_t>());
+        BOOST_CHECK_EQUAL(999, results[i]["routes"][0]["weight"].as<int>());
+        BOOST_CHECK(&snapshot["routes"][1].object_value() == &as_const(results[i])["routes"][1].object_value());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
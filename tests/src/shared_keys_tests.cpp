@@ -0,0 +1,128 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+typedef basic_json<char,shared_keys_policy<>> sk_json;
+typedef basic_json<char,shared_keys_policy<preserve_order_policy>> sk_ojson;
+
+const std::string records = R"(
+[
+    {"name" : "first", "long member name shared by every record" : 1, "" : null},
+    {"name" : "second", "long member name shared by every record" : 2, "" : null},
+    {"name" : "third", "long member name shared by every record" : 3, "" : null}
+]
+)";
+
+template <class Json>
+Json decode(const std::string& s, bool intern)
+{
+    std::istringstream is(s);
+    json_decoder<Json> decoder;
+    decoder.intern_keys(intern);
+    json_reader reader(is, decoder);
+    reader.read();
+    return decoder.get_result();
+}
+
+template <class Json>
+const char* key_data(const Json& record, const std::string& name)
+{
+    return record.object_value().find(name)->key().data();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(shared_keys_tests)
+
+BOOST_AUTO_TEST_CASE(test_shared_string)
+{
+    typedef detail::shared_string<char> shared_string;
+
+    shared_string s("a name", 6);
+    BOOST_CHECK_EQUAL(1, s.use_count());
+    shared_string t(s);
+    BOOST_CHECK_EQUAL(2, s.use_count());
+    BOOST_CHECK(t.data() == s.data());
+    BOOST_CHECK(t == s);
+    BOOST_CHECK(t == shared_string::string_view_type("a name"));
+
+    shared_string u(std::move(t));
+    BOOST_CHECK_EQUAL(2, u.use_count());
+    BOOST_CHECK(t.empty());
+    BOOST_CHECK_EQUAL(0, t.size());
+    BOOST_CHECK_EQUAL(std::string(""), std::string(t.c_str()));
+
+    shared_string v("b", 1);
+    v = s;
+    BOOST_CHECK_EQUAL(3, s.use_count());
+    BOOST_CHECK(v.compare(shared_string("a nam", 5)) > 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_intern_keys)
+{
+    sk_json j = decode<sk_json>(records, true);
+    BOOST_CHECK_EQUAL(json::parse(records).to_string(), j.as<std::string>());
+    BOOST_CHECK(key_data(j[0], "name") == key_data(j[2], "name"));
+    BOOST_CHECK(key_data(j[0], "long member name shared by every record") ==
+                key_data(j[1], "long member name shared by every record"));
+
+    sk_json k = decode<sk_json>(records, false);
+    BOOST_CHECK(k == j);
+    BOOST_CHECK(key_data(k[0], "name") != key_data(k[1], "name"));
+
+    sk_ojson o = decode<sk_ojson>(records, true);
+    BOOST_CHECK_EQUAL(ojson::parse(records).to_string(), o.as<std::string>());
+    BOOST_CHECK(key_data(o[0], "name") == key_data(o[1], "name"));
+
+    // Interning works, without sharing, for std::basic_string keys
+    json l = decode<json>(records, true);
+    BOOST_CHECK(l == json::parse(records));
+}
+
+BOOST_AUTO_TEST_CASE(test_intern_many_keys)
+{
+    // More distinct names than the decoder interns
+    std::ostringstream os;
+    os << "[{";
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        os << (i > 0 ? "," : "") << "\"k" << i << "\":" << i;
+    }
+    os << "},{\"k1\":1,\"k4999\":4999}]";
+
+    sk_json j = decode<sk_json>(os.str(), true);
+    BOOST_CHECK_EQUAL(5000, j[0].size());
+    BOOST_CHECK_EQUAL(4999, j[0]["k4999"].as<int>());
+    BOOST_CHECK(key_data(j[0], "k1") == key_data(j[1], "k1"));
+    BOOST_CHECK(key_data(j[0], "k4999") != key_data(j[1], "k4999"));
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_keys_json)
+{
+    sk_json j = sk_json::parse(R"({"b":1,"a":[true,{"c":"d"}]})");
+    j["e"] = "f";
+    j.insert_or_assign("b", 2);
+    j.erase("a");
+    BOOST_CHECK_EQUAL(std::string(R"({"b":2,"e":"f"})"), j.as<std::string>());
+
+    sk_json copy(j);
+    BOOST_CHECK(copy == j);
+    BOOST_CHECK(key_data(copy, "e") == key_data(j, "e"));
+
+    sk_ojson o;
+    o["z"] = 1;
+    o["y"] = 2;
+    BOOST_CHECK_EQUAL(std::string(R"({"z":1,"y":2})"), o.as<std::string>());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
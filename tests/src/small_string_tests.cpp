@@ -36,5 +36,44 @@ BOOST_AUTO_TEST_CASE(test_small_string)
     BOOST_CHECK(q.as<std::string>() == std::string("ABCD"));
 }
 
+BOOST_AUTO_TEST_CASE(test_small_string_capacity)
+{
+    BOOST_CHECK_EQUAL(16, sizeof(json));
+    size_t max_length = json::variant::small_string_data::max_length;
+    BOOST_CHECK_EQUAL(14, max_length);
+
+    for (size_t length = 0; length <= 16; ++length)
+    {
+        std::string s(length, 'a');
+        json j(s);
+        BOOST_CHECK(j.type_id() == (length <= 14 ? json_type_tag::small_string_t : json_type_tag::string_t));
+        BOOST_CHECK_EQUAL(length, j.as_string_view().length());
+        BOOST_CHECK_EQUAL(s, std::string(j.as_cstring()));
+
+        json copy(j);
+        BOOST_CHECK(copy == j);
+        json other("b");
+        other.swap(copy);
+        BOOST_CHECK_EQUAL(s, other.as<std::string>());
+        BOOST_CHECK_EQUAL(std::string("b"), copy.as<std::string>());
+    }
+
+    json k = json::parse(R"({"fourteen chars":"fourteen chars"})");
+    BOOST_CHECK(k["fourteen chars"].type_id() == json_type_tag::small_string_t);
+    BOOST_CHECK_EQUAL(std::string("fourteen chars"), k["fourteen chars"].as<std::string>());
+
+    wjson w(L"ab");
+    BOOST_CHECK(w.type_id() == json_type_tag::small_string_t);
+    BOOST_CHECK(w.as<std::wstring>() == L"ab");
+}
+
+BOOST_AUTO_TEST_CASE(test_double_number_format)
+{
+    json d(1.5, number_format(3, 2));
+    json copy(d);
+    BOOST_CHECK_EQUAL(3, copy.precision());
+    BOOST_CHECK_EQUAL(2, copy.decimal_places());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
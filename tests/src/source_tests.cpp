@@ -0,0 +1,128 @@
+// Copyright 2018 Daniel Parker
+// Distributed under Boost license
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons_ext/csv/csv_reader.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(source_tests)
+
+BOOST_AUTO_TEST_CASE(test_stream_source_read_buffer)
+{
+    std::istringstream is("[1,2,3]");
+    stream_source<char> source(is);
+
+    char buffer[4];
+    const char* data = nullptr;
+    BOOST_CHECK_EQUAL(4, source.read_buffer(buffer, 4, data));
+    BOOST_CHECK(data == buffer);
+    BOOST_CHECK_EQUAL(3, source.read_buffer(buffer, 4, data));
+    BOOST_CHECK(source.eof());
+    BOOST_CHECK(!source.is_error());
+}
+
+BOOST_AUTO_TEST_CASE(test_string_source)
+{
+    std::string s = "{\"a\":[1,2,3],\"b\":\"text\"}";
+    string_source<char> source(s);
+
+    char buffer[4];
+    const char* data = nullptr;
+    BOOST_CHECK_EQUAL(s.length(), source.read_buffer(buffer, sizeof(buffer), data));
+    BOOST_CHECK(data == s.data());
+    BOOST_CHECK(source.eof());
+    BOOST_CHECK_EQUAL(0, source.read_buffer(buffer, sizeof(buffer), data));
+
+    json_decoder<json> decoder;
+    basic_json_reader<char,std::allocator<char>,string_source<char>> reader(s, decoder);
+    reader.read();
+    BOOST_CHECK(decoder.get_result() == json::parse(s));
+}
+
+BOOST_AUTO_TEST_CASE(test_csv_reader_string_source)
+{
+    std::string s = "a,b\n1,2\n3,4\n";
+
+    json_decoder<json> decoder;
+    csv::csv_parameters params;
+    params.assume_header(true);
+    csv::basic_csv_reader<char,std::allocator<char>,string_source<char>> reader(s, decoder, params);
+    reader.read();
+    json j = decoder.get_result();
+
+    std::istringstream is(s);
+    BOOST_CHECK(j == csv::decode_csv<json>(is, params));
+    BOOST_CHECK_EQUAL(2, j.size());
+    BOOST_CHECK_EQUAL(std::string("3"), j[1]["a"].as<std::string>());
+}
+
+#if defined(JSONCONS_HAS_POSIX_MMAP)
+
+BOOST_AUTO_TEST_CASE(test_fd_source)
+{
+    std::ifstream is("input/address-book.json");
+    json expected = json::parse(is);
+
+    int fd = ::open("input/address-book.json", O_RDONLY);
+    BOOST_REQUIRE(fd != -1);
+    json_decoder<json> decoder;
+    basic_json_reader<char,std::allocator<char>,fd_source<char>> reader(fd, decoder);
+    reader.buffer_length(64);
+    reader.read();
+    ::close(fd);
+    BOOST_CHECK(decoder.get_result() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_fd_source_bad_descriptor)
+{
+    json_decoder<json> decoder;
+    basic_json_reader<char,std::allocator<char>,fd_source<char>> reader(-1, decoder);
+    std::error_code ec;
+    reader.read(ec);
+    BOOST_CHECK(ec == json_parser_errc::source_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_mmap_source)
+{
+    std::ifstream is("input/address-book.json");
+    json expected = json::parse(is);
+
+    json_decoder<json> decoder;
+    basic_json_reader<char,std::allocator<char>,mmap_source<char>> reader(std::string("input/address-book.json"), decoder);
+    reader.read();
+    BOOST_CHECK(decoder.get_result() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_mmap_source_single_chunk)
+{
+    mmap_source<char> source("input/address-book.json");
+    BOOST_REQUIRE(!source.is_error());
+
+    char buffer[16];
+    const char* data = nullptr;
+    size_t length = source.read_buffer(buffer, sizeof(buffer), data);
+    BOOST_CHECK(data == source.data());
+    BOOST_CHECK_EQUAL(source.length(), length);
+    BOOST_CHECK(source.eof());
+    BOOST_CHECK_EQUAL(0, source.read_buffer(buffer, sizeof(buffer), data));
+}
+
+BOOST_AUTO_TEST_CASE(test_mmap_source_missing_file)
+{
+    json_decoder<json> decoder;
+    basic_json_reader<char,std::allocator<char>,mmap_source<char>> reader(std::string("input/no-such-file.json"), decoder);
+    std::error_code ec;
+    reader.read(ec);
+    BOOST_CHECK(ec == json_parser_errc::source_error);
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
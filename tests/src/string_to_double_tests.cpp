@@ -9,6 +9,8 @@
 #include <utility>
 #include <ctime>
 #include <cwchar>
+#include <cstring>
+#include <cstdio>
 #include <jsoncons/detail/number_parsers.hpp>
 
 using namespace jsoncons;
@@ -56,5 +58,48 @@ BOOST_AUTO_TEST_CASE(test_exponent)
     //std::cout << std::numeric_limits<double>::max() << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(test_decimal_to_double_edge_cases)
+{
+    detail::string_to_double reader;
+    std::vector<std::string> inputs = {
+        "0", "-0", "0.0", "1", "0.1", "0.3", "1e23", "9007199254740993",
+        "2.2250738585072011e-308", "2.2250738585072014e-308",
+        "4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+        "1.7976931348623157e308", "1.7976931348623158e308", "1e309", "1e-400",
+        "4503599627370496.5", "4503599627370497.5", "123456789012345678e-10",
+        "1.00000000000000011102230246251565404236316680908203125", "-1.5E-10", "1E+2"
+    };
+    for (const auto& s : inputs)
+    {
+        double expected = strtod(s.c_str(), nullptr);
+        double actual = reader(s.c_str(), s.length());
+        BOOST_CHECK_MESSAGE(std::memcmp(&expected, &actual, sizeof(double)) == 0, s);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_decimal_to_double_round_trip)
+{
+    detail::string_to_double reader;
+    uint64_t bits = 0x123456789abcdefULL;
+    char buf[64];
+    for (int i = 0; i < 100000; ++i)
+    {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        if (!(d == d) || d - d != 0)
+        {
+            continue;
+        }
+        int precision = 1 + i % 17;
+        snprintf(buf, sizeof(buf), "%.*g", precision, d);
+        double expected = strtod(buf, nullptr);
+        double actual = reader(buf, strlen(buf));
+        BOOST_CHECK_MESSAGE(std::memcmp(&expected, &actual, sizeof(double)) == 0, buf);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 